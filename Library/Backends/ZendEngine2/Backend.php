@@ -558,6 +558,19 @@ class Backend extends BaseBackend
         return $code;
     }
 
+    /**
+     * Returns the code that grows the memory frame stack of a method.
+     *
+     * @param ClassMethod        $method
+     * @param CompilationContext $context
+     *
+     * @return string
+     */
+    public function getMemoryGrowCode(ClassMethod $method, CompilationContext $context)
+    {
+        return 'ZEPHIR_MM_GROW();';
+    }
+
     /**
      * Returns the signature of an internal method.
      */
@@ -1166,7 +1179,7 @@ class Backend extends BaseBackend
         $op2 = $this->getVariableCode($variableRight);
 
         $params = ' TSRMLS_CC';
-        if ('zephir_add_function' == $zvalOperator || 'zephir_sub_function' == $zvalOperator) {
+        if (\in_array($zvalOperator, ['zephir_add_function', 'zephir_sub_function', 'zephir_mul_function'])) {
             $params = '';
         }
         $compilationContext->codePrinter->output($zvalOperator.'('.$expected.', '.$op1.', '.$op2.$params.');');
@@ -1520,7 +1533,7 @@ class Backend extends BaseBackend
      *
      * @return array
      */
-    private function resolveOffsetExprs($offsetExprs, CompilationContext $compilationContext)
+    protected function resolveOffsetExprs($offsetExprs, CompilationContext $compilationContext)
     {
         $keys = '';
         $offsetItems = [];
@@ -27,6 +27,26 @@ class FcallManager implements FcallManagerInterface
         return isset($this->requiredMacros[$macro]);
     }
 
+    /**
+     * Returns the macros required so far.
+     *
+     * @return array
+     */
+    public function getRequiredMacros()
+    {
+        return $this->requiredMacros;
+    }
+
+    /**
+     * Adds macros required by another compiler process.
+     *
+     * @param array $macros
+     */
+    public function addRequiredMacros(array $macros)
+    {
+        $this->requiredMacros += $macros;
+    }
+
     /**
      * {@inheritdoc}
      *
@@ -103,6 +103,16 @@ class Backend extends BackendZendEngine2
 
             case 'zend_string':
                 return ['*', 'zend_string'];
+
+            case 'zephir_observer_slots':
+                return ['*', 'zval'];
+
+            /* The call macros of ZTS builds ignore the inline caches */
+            case 'zephir_method_ic':
+                return ['', 'static zephir_method_ic ZEPHIR_ATTR_UNUSED'];
+
+            case 'zephir_instance_ic':
+                return ['', 'static zephir_instance_ic ZEPHIR_ATTR_UNUSED'];
         }
 
         list($pointer, $code) = parent::getTypeDefinition($type);
@@ -212,6 +222,54 @@ class Backend extends BackendZendEngine2
         }
     }
 
+    /**
+     * {@inheritdoc}
+     *
+     * Unless disabled via the "observer-slots" optimization, the method declares
+     * an observer table sized from its symbol table, so observing variables never
+     * reallocates the list of addresses of the memory frame.
+     */
+    public function getMemoryGrowCode(ClassMethod $method, CompilationContext $context)
+    {
+        if (!$context->config->get('observer-slots', 'optimizations')) {
+            return parent::getMemoryGrowCode($method, $context);
+        }
+
+        $symbolTable = $context->symbolTable;
+        $numberSlots = 0;
+        foreach ($symbolTable->getVariables() as $variable) {
+            if ($variable->getNumberUses() <= 0 && !$variable->isExternal()) {
+                continue;
+            }
+
+            if (\in_array($variable->getName(), ['this_ptr', 'return_value', 'return_value_ptr'])) {
+                continue;
+            }
+
+            if (\in_array($variable->getRealName(), ['__$null', '__$true', '__$false'])) {
+                continue;
+            }
+
+            if ($variable->isDoublePointer() || !\in_array($variable->getType(), ['variable', 'string', 'array', 'resource', 'callable', 'object'])) {
+                continue;
+            }
+
+            ++$numberSlots;
+        }
+
+        if (0 == $numberSlots) {
+            return parent::getMemoryGrowCode($method, $context);
+        }
+
+        $observerSlots = new Variable('zephir_observer_slots', 'ZEPHIR_OBSERVER_SLOTS['.$numberSlots.']', $context->branchManager->getCurrentBranch());
+        $observerSlots->increaseUses();
+        $observerSlots->setReusable(false);
+        $observerSlots->setReadOnly(true);
+        $symbolTable->addRawVariable($observerSlots);
+
+        return 'ZEPHIR_MM_GROW_SLOTS(ZEPHIR_OBSERVER_SLOTS);';
+    }
+
     public function generateInitCode(&$groupVariables, $type, $pointer, Variable $variable)
     {
         $isComplex = ('variable' == $type || 'string' == $type || 'array' == $type || 'resource' == $type || 'callable' == $type || 'object' == $type);
@@ -576,11 +634,39 @@ class Backend extends BackendZendEngine2
         //TODO: maybe optimizations (read_nproperty/quick) for thisScope access in NG (as in ZE2 - if necessary)
         if ($property instanceof Variable) {
             $context->codePrinter->output('zephir_read_property_zval('.$symbol.', '.$variableCode.', '.$this->getVariableCode($property).', '.$flags.');');
+        } elseif ($this->usePropertySlot($variableVariable, $property, $context)) {
+            $context->codePrinter->output('zephir_read_property_slot('.$symbol.', '.$variableCode.', '.$context->classDefinition->getClassEntry().', SL("'.$property.'"), '.$flags.');');
         } else {
             $context->codePrinter->output('zephir_read_property('.$symbol.', '.$variableCode.', SL("'.$property.'"), '.$flags.');');
         }
     }
 
+    /**
+     * Checks whether a property of the current object can be accessed through its slot.
+     *
+     * Only properties declared by the class being compiled qualify: the generated
+     * code checks the object is exactly of that class before using the slot, and
+     * falls back to the property handlers otherwise.
+     *
+     * @param Variable           $variable
+     * @param string             $property
+     * @param CompilationContext $context
+     *
+     * @return bool
+     */
+    private function usePropertySlot(Variable $variable, $property, CompilationContext $context)
+    {
+        if ('this' != $variable->getRealName() || !$context->classDefinition ||
+            !$context->config->get('property-slots', 'optimizations')) {
+            return false;
+        }
+
+        $classProperty = $context->classDefinition->getProperty($property);
+
+        return $classProperty && !$classProperty->isStatic() &&
+            $classProperty->getClassDefinition() === $context->classDefinition;
+    }
+
     /**
      * @param Variable        $symbolVariable
      * @param ClassDefinition $classDefinition
@@ -590,10 +676,12 @@ class Backend extends BackendZendEngine2
      */
     public function fetchStaticProperty(Variable $symbolVariable, $classDefinition, $property, $readOnly, CompilationContext $context)
     {
-        // TODO: maybe optimizations as well as above
+        $useSlot = $classDefinition === $context->classDefinition && $this->useStaticPropertySlot($property, $context);
+
         $context->codePrinter->output(
             sprintf(
-                'zephir_read_static_property_ce(%s%s, %s, SL("%s"), PH_NOISY_CC%s);',
+                '%s(%s%s, %s, SL("%s"), PH_NOISY_CC%s);',
+                $useSlot ? 'zephir_read_static_property_slot' : 'zephir_read_static_property_ce',
                 $symbolVariable->isDoublePointer() ? '' : '&',
                 $symbolVariable->getName(),
                 $classDefinition->getClassEntry(),
@@ -603,6 +691,48 @@ class Backend extends BackendZendEngine2
         );
     }
 
+    public function assignStaticPropertyArrayMulti($classEntry, $valueVariable, $propertyName, $offsetExprs, CompilationContext $compilationContext)
+    {
+        if (!$compilationContext->classDefinition ||
+            $classEntry !== $compilationContext->classDefinition->getClassEntry() ||
+            !$this->useStaticPropertySlot($propertyName, $compilationContext)) {
+            parent::assignStaticPropertyArrayMulti($classEntry, $valueVariable, $propertyName, $offsetExprs, $compilationContext);
+
+            return;
+        }
+
+        list($keys, $offsetItems, $numberParams) = $this->resolveOffsetExprs($offsetExprs, $compilationContext);
+        $valueVariable = $this->resolveValue($valueVariable, $compilationContext, true);
+
+        $offsetStr = $offsetItems ? ', '.implode(', ', $offsetItems) : '';
+        $compilationContext->codePrinter->output('zephir_update_static_property_array_multi_slot('.$classEntry.', SL("'.$propertyName.'"), '.$valueVariable.', SL("'.$keys.'"), '.$numberParams.$offsetStr.');');
+    }
+
+    /**
+     * Checks whether a static property of the class being compiled can be
+     * accessed through its slot in the static members table.
+     *
+     * Only properties declared by that class qualify. The kernel resolves the
+     * slot once per call site and falls back to the engine until the statics
+     * of the class are initialized.
+     *
+     * @param string             $property
+     * @param CompilationContext $context
+     *
+     * @return bool
+     */
+    private function useStaticPropertySlot($property, CompilationContext $context)
+    {
+        if (!$context->classDefinition || !$context->config->get('property-slots', 'optimizations')) {
+            return false;
+        }
+
+        $classProperty = $context->classDefinition->getProperty($property);
+
+        return $classProperty && $classProperty->isStatic() &&
+            $classProperty->getClassDefinition() === $context->classDefinition;
+    }
+
     /**
      * @param $value
      * @param CompilationContext $context
@@ -672,6 +802,8 @@ class Backend extends BackendZendEngine2
         $value = $this->resolveValue($value, $context);
         if ($propertyName instanceof Variable) {
             $context->codePrinter->output('zephir_update_property_zval_zval('.$this->getVariableCode($symbolVariable).', '.$this->getVariableCode($propertyName).', '.$value.' TSRMLS_CC);');
+        } elseif ($this->usePropertySlot($symbolVariable, $propertyName, $context)) {
+            $context->codePrinter->output('zephir_update_property_slot('.$this->getVariableCode($symbolVariable).', '.$context->classDefinition->getClassEntry().', SL("'.$propertyName.'"), '.$value.');');
         } else {
             $context->codePrinter->output('zephir_update_property_zval('.$this->getVariableCode($symbolVariable).', SL("'.$propertyName.'"), '.$value.');');
         }
@@ -713,6 +845,31 @@ class Backend extends BackendZendEngine2
         }
     }
 
+    /**
+     * Calls a method using the inline cache of the call site.
+     *
+     * @param Variable|null      $symbolVariable
+     * @param Variable           $variable
+     * @param string             $methodName
+     * @param Variable           $inlineCache
+     * @param array|null         $params
+     * @param CompilationContext $context
+     */
+    public function callMethodInlineCache($symbolVariable, Variable $variable, $methodName, Variable $inlineCache, $params, CompilationContext $context)
+    {
+        $paramStr = null != $params ? ', '.implode(', ', $params) : '';
+        $cache = '&'.$inlineCache->getName();
+
+        if (!isset($symbolVariable)) {
+            $context->codePrinter->output('ZEPHIR_CALL_METHOD_IC(NULL, '.$this->getVariableCode($variable).', "'.$methodName.'", '.$cache.$paramStr.');');
+        } elseif ('return_value' == $symbolVariable->getName()) {
+            $context->codePrinter->output('ZEPHIR_RETURN_CALL_METHOD_IC('.$this->getVariableCode($variable).', "'.$methodName.'", '.$cache.$paramStr.');');
+        } else {
+            $symbol = $this->getVariableCode($symbolVariable);
+            $context->codePrinter->output('ZEPHIR_CALL_METHOD_IC('.$symbol.', '.$this->getVariableCode($variable).', "'.$methodName.'", '.$cache.$paramStr.');');
+        }
+    }
+
     public function setSymbolIfSeparated(Variable $variableTempSeparated, Variable $variable, CompilationContext $context)
     {
         $context->codePrinter->output('if ('.$variableTempSeparated->getName().') {');
@@ -78,7 +78,8 @@ class StringsManager extends BaseStringsManager
             $useCopy = [];
             $avars = [];
             $zvars = [];
-            $svars = [];
+            $buffers = [];
+            $doubles = [];
             $lengths = [];
             $sparams = [];
             $lparams = [];
@@ -86,20 +87,49 @@ class StringsManager extends BaseStringsManager
                 $n = $i + 1;
                 $t = substr($key, $i, 1);
                 $sparams[] = 'op'.$n;
-                if ('s' == $t) {
-                    $params[] = 'const char *op'.$n.', zend_uint op'.$n.'_len';
-                    $lparams[] = 'op'.$n.', sizeof(op'.$n.')-1';
-                    $lengths[] = 'op'.$n.'_len';
-                    $svars[] = $n;
-                    $avars[$n] = 's';
-                } else {
-                    $params[] = 'zval *op'.$n;
-                    $lparams[] = 'op'.$n;
-                    $zvalCopy[] = 'op'.$n.'_copy';
-                    $useCopy[] = 'use_copy'.$n.' = 0';
-                    $lengths[] = 'Z_STRLEN_P(op'.$n.')';
-                    $zvars[] = $n;
-                    $avars[$n] = 'v';
+                $avars[$n] = $t;
+                switch ($t) {
+                    case 's':
+                        $params[] = 'const char *op'.$n.', zend_uint op'.$n.'_len';
+                        $lparams[] = 'op'.$n.', sizeof(op'.$n.')-1';
+                        $lengths[] = 'op'.$n.'_len';
+                        break;
+
+                    case 'l':
+                        $params[] = 'zend_long op'.$n;
+                        $lparams[] = 'op'.$n;
+                        $lengths[] = 'op'.$n.'_len';
+                        $buffers[$n] = 'MAX_LENGTH_OF_LONG + 1';
+                        break;
+
+                    case 'u':
+                        $params[] = 'zend_ulong op'.$n;
+                        $lparams[] = 'op'.$n;
+                        $lengths[] = 'op'.$n.'_len';
+                        $buffers[$n] = 'MAX_LENGTH_OF_LONG + 1';
+                        break;
+
+                    case 'd':
+                        $params[] = 'double op'.$n;
+                        $lparams[] = 'op'.$n;
+                        $lengths[] = 'op'.$n.'_len';
+                        $doubles[] = $n;
+                        break;
+
+                    case 'c':
+                        $params[] = 'char op'.$n;
+                        $lparams[] = 'op'.$n;
+                        $lengths[] = '1';
+                        break;
+
+                    default:
+                        $params[] = 'zval *op'.$n;
+                        $lparams[] = 'op'.$n;
+                        $zvalCopy[] = 'op'.$n.'_copy';
+                        $useCopy[] = 'use_copy'.$n.' = 0';
+                        $lengths[] = 'Z_STRLEN_P(op'.$n.')';
+                        $zvars[] = $n;
+                        break;
                 }
             }
 
@@ -120,7 +150,41 @@ class StringsManager extends BaseStringsManager
                 $code .= "\t".'zval result_copy;'.PHP_EOL;
                 $code .= "\t".'int use_copy = 0;'.PHP_EOL;
             }
-            $code .= "\t".'uint offset = 0, length;'.PHP_EOL.PHP_EOL;
+            $code .= "\t".'uint offset = 0, length;'.PHP_EOL;
+
+            /* Scalars are formatted into stack buffers sized for their longest representation */
+            foreach ($buffers as $n => $size) {
+                $code .= "\t".'char op'.$n.'_buf['.$size.'], *op'.$n.'_str;'.PHP_EOL;
+                $code .= "\t".'size_t op'.$n.'_len;'.PHP_EOL;
+            }
+
+            /* Doubles depend on the precision ini setting, up to 17 digits they fit in 32 bytes */
+            foreach ($doubles as $n) {
+                $code .= "\t".'char op'.$n.'_buf[32], *op'.$n.'_str;'.PHP_EOL;
+                $code .= "\t".'size_t op'.$n.'_len;'.PHP_EOL;
+                $code .= "\t".'zend_string *op'.$n.'_zstr = NULL;'.PHP_EOL;
+            }
+            $code .= PHP_EOL;
+
+            foreach ($buffers as $n => $size) {
+                $print = 'u' == $avars[$n] ? 'zend_print_ulong_to_buf' : 'zend_print_long_to_buf';
+                $code .= "\t".'op'.$n.'_str = '.$print.'(op'.$n.'_buf + sizeof(op'.$n.'_buf) - 1, op'.$n.');'.PHP_EOL;
+                $code .= "\t".'op'.$n.'_len = op'.$n.'_buf + sizeof(op'.$n.'_buf) - 1 - op'.$n.'_str;'.PHP_EOL.PHP_EOL;
+            }
+
+            /* Same format as the string conversion of PHP, which only needs the heap for a higher precision */
+            foreach ($doubles as $n) {
+                $code .= "\t".'if (EG(precision) <= 17) {'.PHP_EOL;
+                $code .= "\t\t".'op'.$n.'_len = slprintf(op'.$n.'_buf, sizeof(op'.$n.'_buf), "%.*G", (int) EG(precision), op'.$n.');'.PHP_EOL;
+                $code .= "\t\t".'op'.$n.'_str = op'.$n.'_buf;'.PHP_EOL;
+                $code .= "\t".'} else {'.PHP_EOL;
+                $code .= "\t\t".'zval op'.$n.'_zv;'.PHP_EOL;
+                $code .= "\t\t".'ZVAL_DOUBLE(&op'.$n.'_zv, op'.$n.');'.PHP_EOL;
+                $code .= "\t\t".'op'.$n.'_zstr = zval_get_string(&op'.$n.'_zv);'.PHP_EOL;
+                $code .= "\t\t".'op'.$n.'_str = ZSTR_VAL(op'.$n.'_zstr);'.PHP_EOL;
+                $code .= "\t\t".'op'.$n.'_len = ZSTR_LEN(op'.$n.'_zstr);'.PHP_EOL;
+                $code .= "\t".'}'.PHP_EOL.PHP_EOL;
+            }
 
             foreach ($zvars as $zvar) {
                 $code .= "\t".'if (Z_TYPE_P(op'.$zvar.') != IS_STRING) {'.PHP_EOL;
@@ -150,18 +214,40 @@ class StringsManager extends BaseStringsManager
 
             $position = '';
             foreach ($avars as $n => $type) {
-                if ('s' == $type) {
-                    $code .= "\t".'memcpy(Z_STRVAL_P(result) + offset'.$position.', op'.$n.', op'.$n.'_len);'.PHP_EOL;
-                    $position .= ' + op'.$n.'_len';
-                } else {
-                    $code .= "\t".'memcpy(Z_STRVAL_P(result) + offset'.$position.', Z_STRVAL_P(op'.$n.'), Z_STRLEN_P(op'.$n.'));'.PHP_EOL;
-                    $position .= ' + Z_STRLEN_P(op'.$n.')';
+                switch ($type) {
+                    case 's':
+                        $code .= "\t".'memcpy(Z_STRVAL_P(result) + offset'.$position.', op'.$n.', op'.$n.'_len);'.PHP_EOL;
+                        $position .= ' + op'.$n.'_len';
+                        break;
+
+                    case 'l':
+                    case 'u':
+                    case 'd':
+                        $code .= "\t".'memcpy(Z_STRVAL_P(result) + offset'.$position.', op'.$n.'_str, op'.$n.'_len);'.PHP_EOL;
+                        $position .= ' + op'.$n.'_len';
+                        break;
+
+                    case 'c':
+                        $code .= "\t".'Z_STRVAL_P(result)[offset'.$position.'] = op'.$n.';'.PHP_EOL;
+                        $position .= ' + 1';
+                        break;
+
+                    default:
+                        $code .= "\t".'memcpy(Z_STRVAL_P(result) + offset'.$position.', Z_STRVAL_P(op'.$n.'), Z_STRLEN_P(op'.$n.'));'.PHP_EOL;
+                        $position .= ' + Z_STRLEN_P(op'.$n.')';
+                        break;
                 }
             }
 
             $code .= "\t".'Z_STRVAL_P(result)[length] = 0;'.PHP_EOL;
             $code .= "\t".'zend_string_forget_hash_val(Z_STR_P(result));'.PHP_EOL;
 
+            foreach ($doubles as $n) {
+                $code .= "\t".'if (op'.$n.'_zstr) {'.PHP_EOL;
+                $code .= "\t".'   zend_string_release(op'.$n.'_zstr);'.PHP_EOL;
+                $code .= "\t".'}'.PHP_EOL.PHP_EOL;
+            }
+
             foreach ($zvars as $zvar) {
                 $code .= "\t".'if (use_copy'.$zvar.') {'.PHP_EOL;
                 $code .= "\t".'   zval_dtor(op'.$zvar.');'.PHP_EOL;
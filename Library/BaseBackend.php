@@ -150,6 +150,8 @@ abstract class BaseBackend implements FcallAwareInterface
 
     abstract public function initVar(Variable $variable, CompilationContext $context, $useCodePrinter = true, $second = false);
 
+    abstract public function getMemoryGrowCode(ClassMethod $method, CompilationContext $context);
+
     abstract public function zvalOperator($zvalOperator, Variable $expected, Variable $variableLeft, Variable $variableRight, CompilationContext $compilationContext);
 
     abstract public function fetchGlobal(Variable $globalVar, CompilationContext $compilationContext, $useCodePrinter = true);
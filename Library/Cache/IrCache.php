@@ -0,0 +1,191 @@
+<?php
+
+/*
+ * This file is part of the Zephir.
+ *
+ * (c) Zephir Team <team@zephir-lang.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code.
+ */
+
+namespace Zephir\Cache;
+
+use Zephir\FileSystem\FileSystemInterface;
+use Zephir\Zephir;
+
+/**
+ * IrCache.
+ *
+ * Keeps the intermediate representation of every file of the project in a single
+ * cache file. Entries are validated by the hash of the source contents and stored
+ * serialized on their own, so the cache is read once and only the entries in use
+ * are unserialized.
+ */
+class IrCache
+{
+    const CACHE_FILE = 'ir.cache';
+
+    /** @var FileSystemInterface */
+    private $filesystem;
+
+    /** @var string */
+    private $signature;
+
+    /** @var array|null */
+    private $entries;
+
+    /**
+     * Paths of the files requested since the cache was created.
+     *
+     * @var bool[]
+     */
+    private $touched = [];
+
+    private $dirty = false;
+
+    private $hits = 0;
+
+    private $misses = 0;
+
+    /**
+     * IrCache constructor.
+     *
+     * @param FileSystemInterface $filesystem
+     * @param string|null         $parserVersion
+     */
+    public function __construct(FileSystemInterface $filesystem, $parserVersion)
+    {
+        $this->filesystem = $filesystem;
+        $this->signature = 'ZEPIR:'.md5(Zephir::VERSION.'|'.$parserVersion.'|'.(\function_exists('igbinary_serialize') ? 'igbinary' : 'php'));
+    }
+
+    /**
+     * Returns the cached intermediate representation of a file.
+     *
+     * @param string $path Absolute path to the *.zep file
+     * @param string $hash Hash of the file contents
+     *
+     * @return array|null
+     */
+    public function get($path, $hash)
+    {
+        $this->load();
+        $this->touched[$path] = true;
+
+        if (isset($this->entries[$path]) && $this->entries[$path][0] === $hash) {
+            $ir = $this->unserialize($this->entries[$path][1]);
+            if (\is_array($ir)) {
+                ++$this->hits;
+
+                return $ir;
+            }
+        }
+
+        ++$this->misses;
+
+        return null;
+    }
+
+    /**
+     * Stores the intermediate representation of a file.
+     *
+     * @param string $path Absolute path to the *.zep file
+     * @param string $hash Hash of the file contents
+     * @param array  $ir
+     */
+    public function set($path, $hash, array $ir)
+    {
+        $this->load();
+        $this->touched[$path] = true;
+
+        $this->entries[$path] = [$hash, $this->serialize($ir)];
+        $this->dirty = true;
+    }
+
+    /**
+     * Writes the cache file if any entry was changed.
+     *
+     * Entries of files that were not requested and no longer exist, such as
+     * deleted or renamed files, are dropped.
+     */
+    public function save()
+    {
+        if (null === $this->entries) {
+            return;
+        }
+
+        foreach (array_keys($this->entries) as $path) {
+            if (!isset($this->touched[$path]) && !file_exists($path)) {
+                unset($this->entries[$path]);
+                $this->dirty = true;
+            }
+        }
+
+        if (!$this->dirty) {
+            return;
+        }
+
+        $this->filesystem->write(self::CACHE_FILE, $this->signature."\n".serialize($this->entries));
+        $this->dirty = false;
+    }
+
+    /**
+     * @return int
+     */
+    public function getHits()
+    {
+        return $this->hits;
+    }
+
+    /**
+     * @return int
+     */
+    public function getMisses()
+    {
+        return $this->misses;
+    }
+
+    private function load()
+    {
+        if (null !== $this->entries) {
+            return;
+        }
+
+        $this->entries = [];
+        if (!$this->filesystem->exists(self::CACHE_FILE)) {
+            return;
+        }
+
+        $contents = $this->filesystem->read(self::CACHE_FILE);
+        $offset = \strlen($this->signature) + 1;
+
+        /* Caches of other versions or serializers are discarded */
+        if (0 === strncmp($contents, $this->signature."\n", $offset)) {
+            $entries = unserialize(substr($contents, $offset));
+            if (\is_array($entries)) {
+                $this->entries = $entries;
+            }
+        }
+    }
+
+    /**
+     * @param array $ir
+     *
+     * @return string
+     */
+    private function serialize(array $ir)
+    {
+        return \function_exists('igbinary_serialize') ? igbinary_serialize($ir) : serialize($ir);
+    }
+
+    /**
+     * @param string $data
+     *
+     * @return mixed
+     */
+    private function unserialize($data)
+    {
+        return \function_exists('igbinary_unserialize') ? igbinary_unserialize($data) : unserialize($data);
+    }
+}
@@ -40,6 +40,8 @@ class MethodCache
 {
     protected $cache = [];
 
+    protected $staticSlots = [];
+
     protected $gatherer;
 
     /**
@@ -55,14 +57,23 @@ class MethodCache
     /**
      * Retrieves/Creates a function cache for a method call.
      *
+     * Only call sites resolved to a single method (final, private, recursive or of a
+     * cacheable class) get a global cache slot, which is shared by the later sites
+     * calling that method. Other sites never reuse a slot allocated elsewhere, so the
+     * generated code does not depend on the order in which files are compiled.
+     *
      * @param CompilationContext $compilationContext
      * @param string             $methodName
      * @param Variable           $caller
+     * @param bool               $staticSlot  Whether the call uses a global cache slot
+     * @param bool               $inlineCache Whether calls without a global cache slot use an inline cache instead
      *
      * @return string
      */
-    public function get(CompilationContext $compilationContext, $methodName, Variable $caller)
+    public function get(CompilationContext $compilationContext, $methodName, Variable $caller, &$staticSlot = null, $inlineCache = false)
     {
+        $staticSlot = false;
+
         $compiler = $compilationContext->compiler;
 
         $numberPoly = 0;
@@ -101,7 +112,7 @@ class MethodCache
 
         if (!$numberPoly) {
             // Try to generate a cache based on the fact the variable is not modified within the loop block
-            if ($compilationContext->insideCycle && !$caller->isTemporal()) {
+            if (!$inlineCache && $compilationContext->insideCycle && !$caller->isTemporal()) {
                 if (\count($compilationContext->cycleBlocks) && 'variable' == $caller->getType()) {
                     $currentBlock = $compilationContext->cycleBlocks[\count($compilationContext->cycleBlocks) - 1];
 
@@ -125,6 +136,12 @@ class MethodCache
 
             $completeName = $method->getClassDefinition()->getCompleteName();
             if (isset($this->cache[$completeName][$method->getName()])) {
+                /* Only monomorphic call sites may share the global slot */
+                $staticSlot = $this->staticSlots[$completeName][$method->getName()];
+                if (!$staticSlot) {
+                    return $this->cache[$completeName][$method->getName()].', 0';
+                }
+
                 return $this->cache[$completeName][$method->getName()].', '.SlotsCache::getExistingMethodSlot($method);
             }
 
@@ -162,10 +179,16 @@ class MethodCache
 
         if ($staticCacheable) {
             $cacheSlot = SlotsCache::getMethodSlot($method);
+            $staticSlot = true;
         } else {
             $cacheSlot = '0';
         }
 
+        // The inline cache replaces the function cache of the call site
+        if ($inlineCache && !$staticCacheable) {
+            return 'NULL, 0';
+        }
+
         if ($cacheable) {
             $functionCacheVar = $compilationContext->symbolTable->getTempVariableForWrite('zephir_fcall_cache_entry', $compilationContext);
             $functionCacheVar->setMustInitNull(true);
@@ -177,11 +200,28 @@ class MethodCache
 
         if (!($method instanceof \ReflectionMethod)) {
             $this->cache[$completeName][$method->getName()] = $functionCache;
+            $this->staticSlots[$completeName][$method->getName()] = $staticCacheable;
         }
 
         return $functionCache.', '.$cacheSlot;
     }
 
+    /**
+     * Creates a per call site inline cache that maps the class of the receiver
+     * to the method resolved for it.
+     *
+     * @param CompilationContext $compilationContext
+     *
+     * @return Variable
+     */
+    public function getInlineCache(CompilationContext $compilationContext)
+    {
+        $inlineCache = $compilationContext->symbolTable->addTemp('zephir_method_ic', $compilationContext);
+        $inlineCache->setReusable(false);
+
+        return $inlineCache;
+    }
+
     /**
      * Checks if the class is suitable for caching.
      *
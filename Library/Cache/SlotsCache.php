@@ -29,6 +29,126 @@ class SlotsCache
 
     private static $cacheFunctionSlots = [];
 
+    /**
+     * Slot lookups of the current file, in order, while recording.
+     *
+     * @var array|null
+     */
+    private static $requests;
+
+    private static $deferred = false;
+
+    /**
+     * Defers the numbering of new slots.
+     *
+     * Files compiled by parallel workers cannot know which slots the files before
+     * them take. New slots are emitted as placeholders instead, which are resolved
+     * once the requests of the files are replayed in the original order.
+     */
+    public static function defer()
+    {
+        self::$deferred = true;
+    }
+
+    /**
+     * Starts recording the slot lookups of a file.
+     */
+    public static function record()
+    {
+        self::$requests = [];
+    }
+
+    /**
+     * Returns the slot lookups recorded since the last call to record() and stops recording.
+     *
+     * Each request is a tuple of type ('f' or 'm'), name, whether the slot is
+     * created when missing and the returned slot.
+     *
+     * @return array
+     */
+    public static function takeRequests()
+    {
+        $requests = (array) self::$requests;
+        self::$requests = null;
+
+        return $requests;
+    }
+
+    /**
+     * Replays slot requests recorded in a worker or in a previous build.
+     *
+     * @param array $requests
+     *
+     * @return int[] the slot returned to each request
+     */
+    public static function replay(array $requests)
+    {
+        $slots = [];
+        foreach ($requests as $request) {
+            list($type, $name, $create) = $request;
+            if (!$create) {
+                $slots[] = self::lookup($type, $name);
+            } elseif ('f' == $type) {
+                $slots[] = self::allocateFunctionSlot($name);
+            } else {
+                list($className, $methodName) = explode('::', $name, 2);
+                $slots[] = self::allocateMethodSlot($className, $methodName);
+            }
+        }
+
+        return $slots;
+    }
+
+    /**
+     * Computes the slots replay() would return, without creating them.
+     *
+     * @param array $requests
+     *
+     * @return int[]
+     */
+    public static function simulate(array $requests)
+    {
+        $next = self::$slot;
+        $created = [];
+
+        $slots = [];
+        foreach ($requests as $request) {
+            list($type, $name, $create) = $request;
+
+            $slot = self::lookup($type, $name);
+            if (!$slot && isset($created[$type.':'.$name])) {
+                $slot = $created[$type.':'.$name];
+            }
+
+            if (!$slot && $create) {
+                $slot = $next++;
+                if ($slot >= self::MAX_SLOTS_NUMBER) {
+                    $slot = 0;
+                } else {
+                    $created[$type.':'.$name] = $slot;
+                }
+            }
+
+            $slots[] = $slot;
+        }
+
+        return $slots;
+    }
+
+    /**
+     * Replaces the slot placeholders in generated code.
+     *
+     * @param string $code
+     *
+     * @return string
+     */
+    public static function resolve($code)
+    {
+        return preg_replace_callback('/%zephir-slot:([fm]):([^%]+)%/', function ($matches) {
+            return self::lookup($matches[1], $matches[2]);
+        }, $code);
+    }
+
     /**
      * Returns or creates a cache slot for a function.
      *
@@ -37,6 +157,26 @@ class SlotsCache
      * @return int
      */
     public static function getFunctionSlot($functionName)
+    {
+        if (isset(self::$cacheFunctionSlots[$functionName])) {
+            $slot = self::$cacheFunctionSlots[$functionName];
+        } elseif (self::$deferred) {
+            $slot = self::placeholder('f', $functionName);
+        } else {
+            $slot = self::allocateFunctionSlot($functionName);
+        }
+
+        return self::request('f', $functionName, true, $slot);
+    }
+
+    /**
+     * Creates a cache slot for a function.
+     *
+     * @param string $functionName
+     *
+     * @return int
+     */
+    private static function allocateFunctionSlot($functionName)
     {
         if (isset(self::$cacheFunctionSlots[$functionName])) {
             return self::$cacheFunctionSlots[$functionName];
@@ -62,10 +202,12 @@ class SlotsCache
     public static function getExistingFunctionSlot($functionName)
     {
         if (isset(self::$cacheFunctionSlots[$functionName])) {
-            return self::$cacheFunctionSlots[$functionName];
+            $slot = self::$cacheFunctionSlots[$functionName];
+        } else {
+            $slot = self::$deferred ? self::placeholder('f', $functionName) : 0;
         }
 
-        return 0;
+        return self::request('f', $functionName, false, $slot);
     }
 
     /**
@@ -80,6 +222,27 @@ class SlotsCache
         $className = $method->getClassDefinition()->getCompleteName();
         $methodName = $method->getName();
 
+        if (isset(self::$cacheMethodSlots[$className][$methodName])) {
+            $slot = self::$cacheMethodSlots[$className][$methodName];
+        } elseif (self::$deferred) {
+            $slot = self::placeholder('m', $className.'::'.$methodName);
+        } else {
+            $slot = self::allocateMethodSlot($className, $methodName);
+        }
+
+        return self::request('m', $className.'::'.$methodName, true, $slot);
+    }
+
+    /**
+     * Creates a cache slot for a method.
+     *
+     * @param string $className
+     * @param string $methodName
+     *
+     * @return int
+     */
+    private static function allocateMethodSlot($className, $methodName)
+    {
         if (isset(self::$cacheMethodSlots[$className][$methodName])) {
             return self::$cacheMethodSlots[$className][$methodName];
         }
@@ -107,9 +270,60 @@ class SlotsCache
         $methodName = $method->getName();
 
         if (isset(self::$cacheMethodSlots[$className][$methodName])) {
-            return self::$cacheMethodSlots[$className][$methodName];
+            $slot = self::$cacheMethodSlots[$className][$methodName];
+        } else {
+            $slot = self::$deferred ? self::placeholder('m', $className.'::'.$methodName) : 0;
+        }
+
+        return self::request('m', $className.'::'.$methodName, false, $slot);
+    }
+
+    /**
+     * Records a slot lookup of the current file.
+     *
+     * @param string     $type
+     * @param string     $name
+     * @param bool       $create
+     * @param int|string $slot
+     *
+     * @return int|string
+     */
+    private static function request($type, $name, $create, $slot)
+    {
+        if (null !== self::$requests) {
+            self::$requests[] = [$type, $name, $create, $slot];
+        }
+
+        return $slot;
+    }
+
+    /**
+     * Returns an existing slot, or 0.
+     *
+     * @param string $type
+     * @param string $name
+     *
+     * @return int
+     */
+    private static function lookup($type, $name)
+    {
+        if ('f' == $type) {
+            return isset(self::$cacheFunctionSlots[$name]) ? self::$cacheFunctionSlots[$name] : 0;
         }
 
-        return 0;
+        list($className, $methodName) = explode('::', $name, 2);
+
+        return isset(self::$cacheMethodSlots[$className][$methodName]) ? self::$cacheMethodSlots[$className][$methodName] : 0;
+    }
+
+    /**
+     * @param string $type
+     * @param string $name
+     *
+     * @return string
+     */
+    private static function placeholder($type, $name)
+    {
+        return '%zephir-slot:'.$type.':'.$name.'%';
     }
 }
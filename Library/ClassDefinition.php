@@ -975,6 +975,35 @@ final class ClassDefinition
         return $method;
     }
 
+    /**
+     * Checks whether all the array defaults initialized for the objects of this
+     * class and its parents are declared as immutable arrays, so the
+     * initialization method is only needed on PHP < 7.3.
+     *
+     * @param CompilationContext $compilationContext
+     *
+     * @return bool
+     */
+    public function hasOnlyImmutableDefaults(CompilationContext $compilationContext)
+    {
+        $classDefinition = $this;
+        do {
+            foreach ($classDefinition->getProperties() as $property) {
+                if ($property->isStatic() || !\in_array($property->getType(), ['array', 'empty-array'], true)) {
+                    continue;
+                }
+
+                if (!$property->hasImmutableDefault($compilationContext)) {
+                    return false;
+                }
+            }
+
+            $classDefinition = $classDefinition->getExtendsClassDefinition();
+        } while ($classDefinition instanceof self);
+
+        return true;
+    }
+
     /**
      * Creates the initialization method.
      *
@@ -1124,7 +1153,14 @@ final class ClassDefinition
 
         $initMethod = $this->getInitMethod();
         if ($initMethod) {
-            $codePrinter->output($namespace.'_'.strtolower($this->getSCName($namespace)).'_ce->create_object = '.$initMethod->getName().';');
+            $createObject = $namespace.'_'.strtolower($this->getSCName($namespace)).'_ce->create_object = '.$initMethod->getName().';';
+            if ($this->hasOnlyImmutableDefaults($compilationContext)) {
+                $codePrinter->output('#if PHP_VERSION_ID < 70300');
+                $codePrinter->output($createObject);
+                $codePrinter->output('#endif');
+            } else {
+                $codePrinter->output($createObject);
+            }
         }
 
         /*
@@ -1523,6 +1523,44 @@ class ClassMethod
         }
     }
 
+    /**
+     * Fetches the parameters from the call frame inline.
+     *
+     * The arity is known at compile time, so the number of arguments is checked
+     * against constants and every parameter is read from its slot directly,
+     * instead of walking a va_list in zephir_fetch_parameters().
+     *
+     * @param string[] $params
+     * @param int      $numberRequiredParams
+     * @param int      $numberOptionalParams
+     * @param bool     $memoryGrow
+     *
+     * @return string
+     */
+    private function fetchParamsInline(array $params, $numberRequiredParams, $numberOptionalParams, $memoryGrow)
+    {
+        if (!$numberOptionalParams) {
+            $wrongNum = 'ZEND_NUM_ARGS() != '.$numberRequiredParams;
+        } elseif (!$numberRequiredParams) {
+            $wrongNum = 'ZEND_NUM_ARGS() > '.$numberOptionalParams;
+        } else {
+            $wrongNum = 'ZEND_NUM_ARGS() < '.$numberRequiredParams.
+                ' || ZEND_NUM_ARGS() > '.($numberRequiredParams + $numberOptionalParams);
+        }
+
+        /* Methods without a memory frame cannot restore it when returning */
+        $macro = $memoryGrow ? 'ZEPHIR_CHECK_PARAMS_NUM' : 'ZEPHIR_CHECK_PARAMS_NUM_WITHOUT_MEMORY_GROW';
+        $code = "\t".$macro.'('.$wrongNum.');'.PHP_EOL;
+
+        /* Parameters are passed by position, the required number of them is always there */
+        foreach (array_values($params) as $i => $param) {
+            $macro = $i < $numberRequiredParams ? 'ZEPHIR_FETCH_PARAM' : 'ZEPHIR_FETCH_OPTIONAL_PARAM';
+            $code .= "\t".$macro.'('.ltrim($param, '&').', '.($i + 1).');'.PHP_EOL;
+        }
+
+        return $code;
+    }
+
     /**
      * Pre-compiles the method making compilation pass data (static inference, local-context-pass) available to other methods.
      *
@@ -2037,7 +2075,17 @@ class ClassMethod
              */
             $codePrinter->preOutputBlankLine();
 
-            if (!$this->isInternal()) {
+            if (!$this->isInternal() && $compilationContext->backend->isZE3()) {
+                $compilationContext->headersManager->add('kernel/memory');
+                $compilationContext->headersManager->add('ext/spl/spl_exceptions');
+                $compilationContext->headersManager->add('kernel/exception');
+                $code .= $this->fetchParamsInline(
+                    $params,
+                    $numberRequiredParams,
+                    $numberOptionalParams,
+                    $symbolTable->getMustGrownStack()
+                );
+            } elseif (!$this->isInternal()) {
                 $compilationContext->headersManager->add('kernel/memory');
                 if ($symbolTable->getMustGrownStack()) {
                     $code .= "\t".'zephir_fetch_params(1, '.$numberRequiredParams.', '.$numberOptionalParams.', '.implode(', ', $params).');'.PHP_EOL;
@@ -2097,7 +2145,7 @@ class ClassMethod
                 $methodGlobals->setReadOnly(true);
                 $compilationContext->symbolTable->addRawVariable($methodGlobals);
             }
-            $codePrinter->preOutput("\t".'ZEPHIR_MM_GROW();');
+            $codePrinter->preOutput("\t".$compilationContext->backend->getMemoryGrowCode($this, $compilationContext));
         }
 
         /**
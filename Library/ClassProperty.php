@@ -245,6 +245,10 @@ class ClassProperty
             case 'array':
             case 'empty-array':
                 $this->initializeArray($compilationContext);
+                if ($this->hasImmutableDefault($compilationContext)) {
+                    $this->declareImmutableArray($compilationContext);
+                    break;
+                }
                 // no break
             case 'null':
                 $this->declareProperty($compilationContext, $this->defaultValue['type'], null);
@@ -262,6 +266,24 @@ class ClassProperty
         }
     }
 
+    /**
+     * Checks whether the default value is an array made only of literals, which
+     * is built once when the class is registered instead of for every object.
+     *
+     * @param CompilationContext $compilationContext
+     *
+     * @return bool
+     */
+    public function hasImmutableDefault(CompilationContext $compilationContext)
+    {
+        if ($this->isStatic() || !$compilationContext->backend->isZE3() ||
+            !$compilationContext->config->get('immutable-default-arrays', 'optimizations')) {
+            return false;
+        }
+
+        return $this->isConstantArray($this->defaultValue);
+    }
+
     /**
      * Removes all initialization statements related to this property.
      *
@@ -400,6 +422,139 @@ class ClassProperty
         }
     }
 
+    /**
+     * Declares the property with an immutable array built at module startup,
+     * shared by every object until it is written. PHP < 7.3 can't declare array
+     * defaults for internal classes, so the initialization method builds them.
+     *
+     * @param CompilationContext $compilationContext
+     */
+    private function declareImmutableArray(CompilationContext $compilationContext)
+    {
+        $codePrinter = $compilationContext->codePrinter;
+        $classEntry = $compilationContext->classDefinition->getClassEntry();
+
+        $variables = [];
+        $lines = [];
+        $variable = $this->buildImmutableArray($this->defaultValue, $variables, $lines);
+
+        $codePrinter->output('#if PHP_VERSION_ID >= 70300');
+        $codePrinter->output('{');
+        $codePrinter->increaseLevel();
+        if (preg_grep('/&value\b/', $lines)) {
+            $variables[] = 'value';
+        }
+
+        $codePrinter->output('zval '.implode(', ', $variables).';');
+        foreach ($lines as $line) {
+            $codePrinter->output($line);
+        }
+        $codePrinter->output('zend_declare_property('.$classEntry.', SL("'.$this->getName().'"), &'.$variable.', '.$this->getVisibilityAccessor().');');
+        $codePrinter->decreaseLevel();
+        $codePrinter->output('}');
+        $codePrinter->output('#else');
+        $this->declareProperty($compilationContext, $this->defaultValue['type'], null);
+        $codePrinter->output('#endif');
+    }
+
+    /**
+     * Produces the code building a constant array, returning the variable holding it.
+     *
+     * @param array $node
+     * @param array $variables
+     * @param array $lines
+     *
+     * @return string
+     */
+    private function buildImmutableArray(array $node, array &$variables, array &$lines)
+    {
+        $variable = 'default_'.\count($variables);
+        $variables[] = $variable;
+
+        if ('empty-array' == $node['type']) {
+            $lines[] = 'ZVAL_EMPTY_ARRAY(&'.$variable.');';
+
+            return $variable;
+        }
+
+        $lines[] = 'zephir_persistent_array_init(&'.$variable.', '.\count($node['left']).');';
+        foreach ($node['left'] as $item) {
+            $value = $item['value'];
+            switch ($value['type']) {
+                case 'array':
+                case 'empty-array':
+                    $valueVariable = $this->buildImmutableArray($value, $variables, $lines);
+                    break;
+
+                case 'int':
+                    $valueVariable = 'value';
+                    $lines[] = 'ZVAL_LONG(&value, '.$value['value'].');';
+                    break;
+
+                case 'double':
+                    $valueVariable = 'value';
+                    $lines[] = 'ZVAL_DOUBLE(&value, '.$value['value'].');';
+                    break;
+
+                case 'bool':
+                    $valueVariable = 'value';
+                    $lines[] = 'ZVAL_BOOL(&value, '.$this->getBooleanCode($value['value']).');';
+                    break;
+
+                case 'null':
+                    $valueVariable = 'value';
+                    $lines[] = 'ZVAL_NULL(&value);';
+                    break;
+
+                default:
+                    $valueVariable = 'value';
+                    $lines[] = 'zephir_persistent_string(&value, SL("'.str_replace(PHP_EOL, '\\n', $value['value']).'"));';
+                    break;
+            }
+
+            if (!isset($item['key'])) {
+                $lines[] = 'zephir_persistent_array_append(&'.$variable.', &'.$valueVariable.');';
+            } elseif ('int' == $item['key']['type']) {
+                $lines[] = 'zephir_persistent_array_update_long(&'.$variable.', '.$item['key']['value'].', &'.$valueVariable.');';
+            } else {
+                $lines[] = 'zephir_persistent_array_update_string(&'.$variable.', SL("'.str_replace(PHP_EOL, '\\n', $item['key']['value']).'"), &'.$valueVariable.');';
+            }
+        }
+        $lines[] = 'zephir_persistent_array_seal(&'.$variable.');';
+
+        return $variable;
+    }
+
+    /**
+     * @param array $node
+     *
+     * @return bool
+     */
+    private function isConstantArray(array $node)
+    {
+        if ('empty-array' == $node['type']) {
+            return true;
+        }
+
+        if ('array' != $node['type']) {
+            return false;
+        }
+
+        foreach ($node['left'] as $item) {
+            if (isset($item['key']) && !\in_array($item['key']['type'], ['int', 'string'], true)) {
+                return false;
+            }
+
+            $value = $item['value'];
+            if (!\in_array($value['type'], ['int', 'double', 'bool', 'null', 'string'], true) &&
+                !$this->isConstantArray($value)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     private function initializeArray($compilationContext)
     {
         $classDefinition = $this->classDefinition;
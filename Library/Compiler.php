@@ -13,6 +13,8 @@ namespace Zephir;
 
 use Psr\Log\LoggerAwareTrait;
 use Psr\Log\NullLogger;
+use Zephir\Cache\IrCache;
+use Zephir\Cache\SlotsCache;
 use Zephir\Compiler\CompilerFileFactory;
 use Zephir\Exception\CompilerException;
 use Zephir\Exception\IllegalStateException;
@@ -93,6 +95,12 @@ final class Compiler
     /** @var CompilerFileFactory */
     private $compilerFileFactory;
 
+    /** @var IrCache|null */
+    private $irCache;
+
+    /** @var DependencyMap|null */
+    private $dependencyMap;
+
     /**
      * Compiler constructor.
      *
@@ -212,6 +220,20 @@ final class Compiler
         return $this->parserManager;
     }
 
+    /**
+     * Returns the cache of intermediate representations of the project.
+     *
+     * @return IrCache
+     */
+    public function getIrCache()
+    {
+        if (!$this->irCache) {
+            $this->irCache = new IrCache($this->filesystem, $this->parserManager->getParserVersion());
+        }
+
+        return $this->irCache;
+    }
+
     /**
      * Adds a function to the function definitions.
      *
@@ -284,6 +306,10 @@ final class Compiler
      */
     public function isClass($className)
     {
+        if ($this->dependencyMap) {
+            $this->dependencyMap->addDependency($className);
+        }
+
         foreach ($this->definitions as $key => $value) {
             if (!strcasecmp($key, $className) && 'class' === $value->getType()) {
                 return true;
@@ -317,6 +343,10 @@ final class Compiler
      */
     public function isInterface($className)
     {
+        if ($this->dependencyMap) {
+            $this->dependencyMap->addDependency($className);
+        }
+
         foreach ($this->definitions as $key => $value) {
             if (!strcasecmp($key, $className) && 'interface' === $value->getType()) {
                 return true;
@@ -370,6 +400,10 @@ final class Compiler
      */
     public function getClassDefinition($className)
     {
+        if ($this->dependencyMap) {
+            $this->dependencyMap->addDependency($className);
+        }
+
         foreach ($this->definitions as $key => $value) {
             if (!strcasecmp($key, $className)) {
                 return $value;
@@ -550,6 +584,7 @@ final class Compiler
      * Generates the C sources from Zephir without compiling them.
      *
      * @param bool $fromGenerate
+     * @param int  $jobs         Number of processes compiling files
      *
      * @return bool
      *
@@ -558,7 +593,7 @@ final class Compiler
      * @throws IllegalStateException
      * @throws InvalidArgumentException
      */
-    public function generate($fromGenerate = false)
+    public function generate($fromGenerate = false, $jobs = 1)
     {
         /*
          * Get global namespace.
@@ -594,6 +629,14 @@ final class Compiler
             );
         }
 
+        $irCache = $this->getIrCache();
+        $irCache->save();
+        if ($this->config->get('verbose')) {
+            $this->logger->info(
+                sprintf('IR cache: %d hits, %d misses', $irCache->getHits(), $irCache->getMisses())
+            );
+        }
+
         /*
          * Round 2. Check 'extends' and 'implements' dependencies
          */
@@ -700,28 +743,17 @@ final class Compiler
         $files = [];
 
         $hash = '';
-        foreach ($this->files as $compileFile) {
-            /*
-             * Only compile classes in the local extension, ignore external classes
-             */
-            if (!$compileFile->isExternal()) {
-                $compileFile->compile($this, $this->stringManager);
-                $compiledFile = $compileFile->getCompiledFile();
+        foreach ($this->compileFiles($jobs) as $compiled) {
+            list($compiledFile, $classDefinition, $methods, $initializers) = $compiled;
 
-                $methods = [];
-                $classDefinition = $compileFile->getClassDefinition();
-                foreach ($classDefinition->getMethods() as $method) {
-                    $methods[] = '['.$method->getName().':'.implode('-', $method->getVisibility()).']';
-                    if ($method->isInitializer() && $method->isStatic()) {
-                        $this->internalInitializers[] = "\t".$method->getName().'(TSRMLS_C);';
-                    }
-                }
+            foreach ($initializers as $initializer) {
+                $this->internalInitializers[] = "\t".$initializer.'(TSRMLS_C);';
+            }
 
-                $files[] = $compiledFile;
+            $files[] = $compiledFile;
 
-                $hash .= '|'.$compiledFile.':'.$classDefinition->getClassEntry().
-                        '['.implode('|', $methods).']';
-            }
+            $hash .= '|'.$compiledFile.':'.$classDefinition->getClassEntry().
+                    '['.implode('|', $methods).']';
         }
 
         /*
@@ -802,6 +834,9 @@ final class Compiler
         $this->stringManager->genConcatCode();
         $this->fcallManager->genFcallCode();
 
+        /* External classes may have been loaded while compiling */
+        $this->getIrCache()->save();
+
         if ($this->config->get('stubs-run-after-generate', 'stubs')) {
             $this->stubs($fromGenerate);
         }
@@ -809,14 +844,399 @@ final class Compiler
         return $needConfigure;
     }
 
+    /**
+     * Compiles the local files to C sources, in the order of their dependency ranking.
+     *
+     * Files whose source, dependencies and cache slots did not change since the
+     * previous build are not compiled again: the state they registered in the
+     * compiler is restored from the dependency map instead.
+     *
+     * Returns the compiled file, class definition, method signatures and static
+     * initializers of each file.
+     *
+     * @param int $jobs
+     *
+     * @return array
+     *
+     * @throws CompilerException
+     */
+    private function compileFiles($jobs)
+    {
+        /* Internal methods are set up while compiling their class, so every file has to be compiled */
+        $internalCalls = $this->config->get('internal-call-transformation', 'optimizations');
+
+        $parallel = $jobs > 1 && \function_exists('pcntl_fork') && \function_exists('posix_kill') && !$internalCalls;
+
+        if ($jobs > 1 && !$parallel) {
+            $this->logger->warning('Parallel generation is not available, compiling files serially');
+        }
+
+        $this->dependencyMap = new DependencyMap($this->filesystem, $this->getBuildSignature());
+        $this->dependencyMap->computeChanges($this->files);
+
+        /*
+         * Files of the same rank do not depend on each other: compile them in workers
+         * and merge the results back in the original order
+         */
+        $ranks = [];
+        foreach ($this->files as $compileFile) {
+            if (!$compileFile->isExternal()) {
+                $ranks[$compileFile->getClassDefinition()->getDependencyRank()][] = $compileFile;
+                continue;
+            }
+
+            /* Only the hash is kept, to know whether the class changed in the next build */
+            $this->dependencyMap->setRecord(
+                $compileFile->getClassDefinition()->getCompleteName(),
+                ['hash' => $compileFile->getSourceHash(), 'dependencies' => []]
+            );
+        }
+
+        $compiled = [];
+        $unchanged = 0;
+        foreach ($ranks as $rankFiles) {
+            $records = [];
+            foreach ($rankFiles as $i => $compileFile) {
+                $record = $internalCalls ? null : $this->getUnchangedRecord($compileFile);
+                if ($record) {
+                    $records[$i] = $record;
+                }
+            }
+
+            $results = [];
+            if ($parallel) {
+                $results = $this->compileInWorkers(
+                    array_filter($rankFiles, function (CompilerFile $compileFile, $i) use ($records) {
+                        return !isset($records[$i]) && $compileFile->isSelfContained();
+                    }, ARRAY_FILTER_USE_BOTH),
+                    $jobs
+                );
+            }
+
+            foreach ($rankFiles as $i => $compileFile) {
+                $classDefinition = $compileFile->getClassDefinition();
+
+                /* The sources of a file embed its cache slots, which depend on the files before it */
+                if (isset($records[$i]) && SlotsCache::simulate($records[$i]['slots']) == $records[$i]['slotNumbers']) {
+                    $record = $records[$i];
+                    SlotsCache::replay($record['slots']);
+                    ++$unchanged;
+                } elseif (isset($results[$i])) {
+                    $record = $results[$i];
+                    $record['slotNumbers'] = SlotsCache::replay($record['slots']);
+                    foreach ($record['output'] as $path => $output) {
+                        $compileFile->writeOutput($path, SlotsCache::resolve($output));
+                    }
+                } else {
+                    $record = $this->compileFile($compileFile);
+                }
+                unset($record['output']);
+
+                foreach ($record['concatKeys'] as $key => $one) {
+                    $this->stringManager->addConcatKey($key);
+                }
+                $this->fcallManager->addRequiredMacros($record['macros']);
+
+                $this->dependencyMap->setRecord($classDefinition->getCompleteName(), $record);
+
+                $compiled[] = [
+                    $record['compiledFile'],
+                    $classDefinition,
+                    $record['methods'],
+                    $record['initializers'],
+                ];
+            }
+        }
+
+        $this->dependencyMap->save();
+        $this->dependencyMap = null;
+
+        if ($this->config->get('verbose')) {
+            $this->logger->info(sprintf('Incremental build: %d of %d files unchanged', $unchanged, \count($compiled)));
+        }
+
+        return $compiled;
+    }
+
+    /**
+     * Compiles a file, recording the state it registers in the compiler.
+     *
+     * Concatenation functions and call macros are collected apart from the ones
+     * of the other files, so the record of the file is complete even if another
+     * file requested them first.
+     *
+     * @param CompilerFile $compileFile
+     *
+     * @return array
+     *
+     * @throws CompilerException
+     */
+    private function compileFile(CompilerFile $compileFile)
+    {
+        $stringsManager = $this->backend->getStringsManager();
+
+        $fcallManagerClass = \get_class($this->fcallManager);
+        $fcallManager = new $fcallManagerClass();
+        $this->backend->setFcallManager($fcallManager);
+
+        SlotsCache::record();
+        $this->dependencyMap->startRecording();
+
+        try {
+            $compileFile->compile($this, $stringsManager);
+        } finally {
+            $this->backend->setFcallManager($this->fcallManager);
+            $dependencies = $this->dependencyMap->stopRecording();
+            $requests = SlotsCache::takeRequests();
+        }
+
+        $classDefinition = $compileFile->getClassDefinition();
+
+        $slots = [];
+        $slotNumbers = [];
+        foreach ($requests as $request) {
+            $slots[] = [$request[0], $request[1], $request[2]];
+            $slotNumbers[] = $request[3];
+        }
+
+        return [
+            'hash' => $compileFile->getSourceHash(),
+            'dependencies' => $dependencies,
+            'compiledFile' => $compileFile->getCompiledFile(),
+            'outputs' => $compileFile->getOutputPaths(),
+            'output' => $compileFile->getDeferredOutput(),
+            'methods' => $this->getMethodSignatures($classDefinition),
+            'initializers' => $this->getStaticInitializers($classDefinition),
+            'slots' => $slots,
+            'slotNumbers' => $slotNumbers,
+            'concatKeys' => $stringsManager->getConcatKeys(),
+            'macros' => $fcallManager->getRequiredMacros(),
+        ];
+    }
+
+    /**
+     * Returns the record of the previous build of a file if it does not need to be compiled.
+     *
+     * @param CompilerFile $compileFile
+     *
+     * @return array|null
+     */
+    private function getUnchangedRecord(CompilerFile $compileFile)
+    {
+        if (!$compileFile->isSelfContained()) {
+            return null;
+        }
+
+        $record = $this->dependencyMap->getRecord(
+            $compileFile->getClassDefinition()->getCompleteName(),
+            $compileFile->getSourceHash()
+        );
+
+        if (!$record) {
+            return null;
+        }
+
+        foreach ($record['outputs'] as $path) {
+            if (!file_exists($path)) {
+                return null;
+            }
+        }
+
+        return $record;
+    }
+
+    /**
+     * Returns a signature of everything affecting the code generated for all the files.
+     *
+     * @return string
+     */
+    private function getBuildSignature()
+    {
+        $signature = \get_class($this->backend).'|'.json_encode($this->config);
+
+        /* Generated code also depends on the compiler, its kernel and its templates */
+        $signature .= '|'.$this->getSourcesHash([
+            __DIR__,
+            $this->backend->getInternalKernelPath(),
+            $this->backend->getInternalTemplatePath(),
+        ]);
+
+        /* Functions are called by name from any file */
+        foreach ($this->files as $compileFile) {
+            if (\count($compileFile->getFunctionDefinitions())) {
+                $signature .= '|'.$compileFile->getSourceHash();
+            }
+        }
+
+        $constantsSources = $this->config->get('constants-sources');
+        if (\is_array($constantsSources)) {
+            foreach ($constantsSources as $constantsSource) {
+                $signature .= '|'.(file_exists($constantsSource) ? md5_file($constantsSource) : '');
+            }
+        }
+
+        return $signature;
+    }
+
+    /**
+     * Hashes the contents of every file in the given directories.
+     *
+     * @param string[] $paths
+     *
+     * @return string
+     */
+    private function getSourcesHash(array $paths)
+    {
+        $hashes = [];
+        foreach ($paths as $path) {
+            if (!is_dir($path)) {
+                continue;
+            }
+
+            $iterator = new \RecursiveIteratorIterator(
+                new \RecursiveDirectoryIterator($path, \FilesystemIterator::SKIP_DOTS)
+            );
+
+            foreach ($iterator as $item) {
+                if ($item->isFile()) {
+                    $hashes[$item->getPathname()] = md5_file($item->getPathname());
+                }
+            }
+        }
+
+        ksort($hashes, SORT_STRING);
+
+        return md5(serialize($hashes));
+    }
+
+    /**
+     * Compiles files in forked worker processes.
+     *
+     * Each worker defers the numbering of cache slots and the writing of sources,
+     * the records of the files are returned keyed like the given files.
+     *
+     * @param CompilerFile[] $compileFiles
+     * @param int            $jobs
+     *
+     * @return array
+     *
+     * @throws CompilerException
+     */
+    private function compileInWorkers(array $compileFiles, $jobs)
+    {
+        if (\count($compileFiles) < 2) {
+            return [];
+        }
+
+        $chunks = [];
+        $n = 0;
+        foreach ($compileFiles as $i => $compileFile) {
+            $chunks[$n++ % $jobs][$i] = $compileFile;
+        }
+
+        $workers = [];
+        foreach ($chunks as $chunk) {
+            $resultFile = tempnam(sys_get_temp_dir(), 'zephir');
+
+            $pid = pcntl_fork();
+            if (-1 == $pid) {
+                throw new CompilerException('Unable to fork a worker process');
+            }
+
+            if (0 == $pid) {
+                $result = [];
+                try {
+                    SlotsCache::defer();
+                    foreach ($chunk as $i => $compileFile) {
+                        $compileFile->setDeferredOutput(true);
+                        $result['files'][$i] = $this->compileFile($compileFile);
+                    }
+                } catch (\Throwable $e) {
+                    $result = ['error' => $e->getMessage()];
+                }
+
+                file_put_contents($resultFile, serialize($result));
+
+                /* A plain exit would run the shutdown functions and destructors inherited from the parent */
+                posix_kill(getmypid(), SIGKILL);
+            }
+
+            $workers[$pid] = $resultFile;
+        }
+
+        $results = [];
+        $errors = [];
+        foreach ($workers as $pid => $resultFile) {
+            pcntl_waitpid($pid, $status);
+
+            $result = unserialize(file_get_contents($resultFile));
+            unlink($resultFile);
+
+            /* Workers kill themselves once their result is written */
+            if (!pcntl_wifsignaled($status) || SIGKILL != pcntl_wtermsig($status)) {
+                $errors[] = pcntl_wifexited($status)
+                    ? sprintf('Worker process %d exited with status %d', $pid, pcntl_wexitstatus($status))
+                    : sprintf('Worker process %d was terminated by signal %d', $pid, pcntl_wtermsig($status));
+                continue;
+            }
+
+            if (!\is_array($result) || isset($result['error'])) {
+                $errors[] = \is_array($result) ? $result['error'] : 'Worker process '.$pid.' failed';
+                continue;
+            }
+
+            $results += $result['files'];
+        }
+
+        if ($errors) {
+            throw new CompilerException(implode(PHP_EOL, $errors));
+        }
+
+        return $results;
+    }
+
+    /**
+     * @param ClassDefinition $classDefinition
+     *
+     * @return string[]
+     */
+    private function getMethodSignatures(ClassDefinition $classDefinition)
+    {
+        $methods = [];
+        foreach ($classDefinition->getMethods() as $method) {
+            $methods[] = '['.$method->getName().':'.implode('-', $method->getVisibility()).']';
+        }
+
+        return $methods;
+    }
+
+    /**
+     * @param ClassDefinition $classDefinition
+     *
+     * @return string[]
+     */
+    private function getStaticInitializers(ClassDefinition $classDefinition)
+    {
+        $initializers = [];
+        foreach ($classDefinition->getMethods() as $method) {
+            if ($method->isInitializer() && $method->isStatic()) {
+                $initializers[] = $method->getName();
+            }
+        }
+
+        return $initializers;
+    }
+
     /**
      * Compiles the extension without installing it.
      *
-     * @param bool $development
+     * @param bool     $development
+     * @param int|null $jobs        Number of parallel make jobs, defaults to the number of CPUs
+     * @param bool     $timings     Whether to record the CPU time spent compiling each file
      *
      * @throws CompilerException|Exception
      */
-    public function compile($development = false)
+    public function compile($development = false, $jobs = null, $timings = false)
     {
         /**
          * Get global namespace.
@@ -906,13 +1326,120 @@ final class Compiler
             );
         } else {
             $this->preCompileHeaders();
+
+            $make = 'make -s -j'.make_jobs($jobs);
+            if ($timings) {
+                $timingsFile = tempnam(sys_get_temp_dir(), 'zephir');
+                $shell = $this->createTimingShell($timingsFile, $this->getMakefileShell('ext/Makefile'));
+                $make .= ' SHELL='.escapeshellarg($shell);
+            }
+
             exec(
-                'cd ext && (make -s -j2 2>'.$currentDir.'/compile-errors.log 1>'.
+                'cd ext && ('.$make.
+                ' 2>'.$currentDir.'/compile-errors.log 1>'.
                 $currentDir.
                 '/compile.log)',
                 $output,
                 $exit
             );
+
+            if ($timings) {
+                $this->reportTimings($timingsFile, $currentDir.'/compile-timings.log');
+
+                unlink($shell);
+                unlink($timingsFile);
+            }
+        }
+    }
+
+    /**
+     * Returns the shell a Makefile runs its recipes with.
+     *
+     * @param string $makefile
+     *
+     * @return string
+     */
+    private function getMakefileShell($makefile)
+    {
+        if (is_readable($makefile) && preg_match('/^SHELL\s*=\s*(\S+)\s*$/m', file_get_contents($makefile), $matches)) {
+            return $matches[1];
+        }
+
+        return '/bin/sh';
+    }
+
+    /**
+     * Writes the shell make runs the recipes with, which records the CPU time
+     * each translation unit took to compile. The usage of the terminated children
+     * of the wrapper covers the recipe alone, not the start-up of the wrapper.
+     *
+     * @param string $timingsFile
+     * @param string $originalShell The shell the recipes are passed on to
+     *
+     * @return string path to the shell
+     */
+    private function createTimingShell($timingsFile, $originalShell)
+    {
+        $shell = tempnam(sys_get_temp_dir(), 'zephir');
+
+        $script = <<<'PHP'
+#!:php
+<?php
+$command = end($argv);
+passthru(implode(' ', array_map('escapeshellarg', array_merge([:shell], array_slice($argv, 1)))), $status);
+if (preg_match('/\s-c\s+(\S+\.c)(\s|$)/', $command, $matches)) {
+    $usage = getrusage(1);
+    $seconds = $usage['ru_utime.tv_sec'] + $usage['ru_stime.tv_sec'] + ($usage['ru_utime.tv_usec'] + $usage['ru_stime.tv_usec']) / 1e6;
+    $line = sprintf("%s\t%.3f\n", $matches[1], $seconds);
+    file_put_contents(:timings, $line, FILE_APPEND | LOCK_EX);
+}
+exit($status);
+
+PHP;
+
+        file_put_contents($shell, strtr($script, [
+            ':php' => PHP_BINARY,
+            ':timings' => var_export($timingsFile, true),
+            ':shell' => var_export($originalShell, true),
+        ]));
+        chmod($shell, 0755);
+
+        return $shell;
+    }
+
+    /**
+     * Writes the CPU time spent compiling each translation unit, slowest first,
+     * and logs the slowest ones. The total is summed over parallel make jobs.
+     *
+     * @param string $timingsFile
+     * @param string $reportFile
+     */
+    private function reportTimings($timingsFile, $reportFile)
+    {
+        $timings = [];
+        foreach (file($timingsFile, FILE_IGNORE_NEW_LINES | FILE_SKIP_EMPTY_LINES) as $line) {
+            list($source, $seconds) = explode("\t", $line, 2);
+            $source = str_replace(getcwd().'/ext/', '', $source);
+            $timings[$source] = (isset($timings[$source]) ? $timings[$source] : 0) + (float) $seconds;
+        }
+
+        if (!$timings) {
+            return;
+        }
+
+        arsort($timings);
+
+        $report = '';
+        foreach ($timings as $source => $seconds) {
+            $report .= sprintf('%8.3fs %s', $seconds, $source).PHP_EOL;
+        }
+        file_put_contents($reportFile, $report);
+
+        $this->logger->info(
+            sprintf('Compiled %d files using %.3fs of CPU time, the slowest were:', \count($timings), array_sum($timings))
+        );
+        foreach (\array_slice($timings, 0, 10, true) as $source => $seconds) {
+            $this->logger->info(sprintf('%8.3fs %s', $seconds, $source));
         }
     }
 
@@ -972,13 +1499,15 @@ final class Compiler
      *
      * TODO: Move to the separated installer
      *
-     * @param bool $development
+     * @param bool     $development
+     * @param int|null $jobs        Number of parallel make jobs, defaults to the number of CPUs
+     * @param bool     $timings     Whether to record the time spent compiling each file
      *
      * @throws Exception
      * @throws NotImplementedException
      * @throws CompilerException
      */
-    public function install($development = false)
+    public function install($development = false, $jobs = null, $timings = false)
     {
         // Get global namespace
         $namespace = str_replace('\\', '_', $this->checkDirectory());
@@ -1000,7 +1529,7 @@ final class Compiler
             unlink("{$currentDir}/ext/modules/{$namespace}.so");
         }
 
-        $this->compile($development);
+        $this->compile($development, $jobs, $timings);
 
         $this->logger->info('Installing...');
 
@@ -1009,10 +1538,11 @@ final class Compiler
         $command = strtr(
             // TODO: Sort out with sudo
             'cd ext && export CC="gcc" && export CFLAGS=":cflags" && '.
-            'make 2>> ":stderr" 1>> ":stdout" && '.
+            'make -j:jobs 2>> ":stderr" 1>> ":stdout" && '.
             'sudo make install 2>> ":stderr" 1>> ":stdout"',
             [
                 ':cflags' => $gccFlags,
+                ':jobs' => make_jobs($jobs),
                 ':stderr' => "{$currentDir}/compile-errors.log",
                 ':stdout' => "{$currentDir}/compile.log",
             ]
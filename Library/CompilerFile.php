@@ -76,6 +76,27 @@ final class CompilerFile implements FileInterface
      */
     private $headerCBlocks = [];
 
+    /**
+     * Generated sources kept in memory instead of being written, keyed by path.
+     *
+     * @var array|null
+     */
+    private $deferredOutput;
+
+    /**
+     * Paths of the generated sources.
+     *
+     * @var string[]
+     */
+    private $outputPaths = [];
+
+    /**
+     * Hash of the contents of the *.zep file.
+     *
+     * @var string|null
+     */
+    private $sourceHash;
+
     /**
      * @var Config
      */
@@ -146,6 +167,83 @@ final class CompilerFile implements FileInterface
         return $this->functionDefinitions;
     }
 
+    /**
+     * Checks whether the file can be compiled in a process apart from the other files.
+     *
+     * Functions and closures register state in the compiler while being compiled,
+     * so files declaring them are compiled by the main process.
+     *
+     * @return bool
+     */
+    public function isSelfContained()
+    {
+        return !\count($this->functionDefinitions) && \is_array($this->ir) && !$this->hasClosures($this->ir);
+    }
+
+    /**
+     * Keeps the generated sources in memory instead of writing them.
+     *
+     * @param bool $deferred
+     */
+    public function setDeferredOutput($deferred)
+    {
+        $this->deferredOutput = $deferred ? [] : null;
+    }
+
+    /**
+     * Returns the generated sources kept in memory, keyed by path.
+     *
+     * @return array
+     */
+    public function getDeferredOutput()
+    {
+        return (array) $this->deferredOutput;
+    }
+
+    /**
+     * Writes a generated source file.
+     *
+     * Use md5 hash to avoid rewrite the file again and again when it hasn't changed
+     * thus avoiding unnecessary recompilations.
+     *
+     * @param string $path
+     * @param string $output
+     */
+    public function writeOutput($path, $output)
+    {
+        $this->outputPaths[] = $path;
+
+        if (null !== $this->deferredOutput) {
+            $this->deferredOutput[$path] = $output;
+
+            return;
+        }
+
+        if (!file_exists($path) || md5($output) != $this->filesystem->getHashFile('md5', $path, true)) {
+            file_put_contents($path, $output);
+        }
+    }
+
+    /**
+     * Returns the paths of the sources generated by the last compilation.
+     *
+     * @return string[]
+     */
+    public function getOutputPaths()
+    {
+        return $this->outputPaths;
+    }
+
+    /**
+     * Returns the hash of the contents of the *.zep file.
+     *
+     * @return string|null
+     */
+    public function getSourceHash()
+    {
+        return $this->sourceHash;
+    }
+
     /**
      * Sets if the class belongs to an external dependency or not.
      *
@@ -189,7 +287,10 @@ final class CompilerFile implements FileInterface
     }
 
     /**
-     * Compiles the file generating a JSON intermediate representation.
+     * Compiles the file generating an intermediate representation.
+     *
+     * The representation is kept in the project IR cache, validated by the hash
+     * of the file contents.
      *
      * @param Compiler $compiler
      *
@@ -200,40 +301,22 @@ final class CompilerFile implements FileInterface
      */
     public function genIR(Compiler $compiler)
     {
-        $normalizedPath = $this->filesystem->normalizePath($this->filePath);
-
-        // TODO: JS => JSON
-        $compilePath = "{$normalizedPath}.js";
         $zepRealPath = realpath($this->filePath);
+        $hash = hash_file('md5', $zepRealPath);
+        $this->sourceHash = $hash;
 
-        if ($this->filesystem->exists($compilePath)) {
-            $modificationTime = $this->filesystem->modificationTime($compilePath);
-            if ($modificationTime < filemtime($zepRealPath)) {
-                $this->filesystem->delete($compilePath);
-                if (false != $this->filesystem->exists($compilePath.'.php')) {
-                    $this->filesystem->delete($compilePath.'.php');
-                }
-            }
-        }
+        $irCache = $compiler->getIrCache();
 
-        $ir = null;
-        if (false == $this->filesystem->exists($compilePath)) {
+        $contents = $irCache->get($zepRealPath, $hash);
+        if (null === $contents) {
             $parser = $compiler->getParserManager()->getParser();
-            $ir = $parser->parse($zepRealPath);
-            $this->filesystem->write($compilePath, json_encode($ir, JSON_PRETTY_PRINT));
-        }
+            $contents = $parser->parse($zepRealPath);
 
-        if (false == $this->filesystem->exists($compilePath.'.php')) {
-            if (empty($ir)) {
-                $ir = json_decode($this->filesystem->read($compilePath), true);
+            if (\is_array($contents)) {
+                $irCache->set($zepRealPath, $hash, $contents);
             }
-
-            $data = '<?php return '.var_export($ir, true).';';
-            $this->filesystem->write($compilePath.'.php', $data);
         }
 
-        $contents = $this->filesystem->requireFile($compilePath.'.php');
-
         if (false == \is_array($contents)) {
             throw new IllegalStateException(
                 sprintf(
@@ -797,6 +880,8 @@ final class CompilerFile implements FileInterface
             return;
         }
 
+        $this->outputPaths = [];
+
         /**
          * Compilation context stores common objects required by compilation entities.
          */
@@ -902,32 +987,9 @@ final class CompilerFile implements FileInterface
         }
 
         if ($codePrinter) {
-            /*
-             * If the file does not exists we create it for the first time
-             */
-            if (!file_exists($filePath)) {
-                file_put_contents($filePath, $codePrinter->getOutput());
-                if ($compilationContext->headerPrinter) {
-                    file_put_contents($filePathHeader, $compilationContext->headerPrinter->getOutput());
-                }
-            } else {
-                /**
-                 * Use md5 hash to avoid rewrite the file again and again when it hasn't changed
-                 * thus avoiding unnecessary recompilations.
-                 */
-                $output = $codePrinter->getOutput();
-                $hash = $this->filesystem->getHashFile('md5', $filePath, true);
-                if (md5($output) != $hash) {
-                    file_put_contents($filePath, $output);
-                }
-
-                if ($compilationContext->headerPrinter) {
-                    $output = $compilationContext->headerPrinter->getOutput();
-                    $hash = $this->filesystem->getHashFile('md5', $filePathHeader, true);
-                    if (md5($output) != $hash) {
-                        file_put_contents($filePathHeader, $output);
-                    }
-                }
+            $this->writeOutput($filePath, $codePrinter->getOutput());
+            if ($compilationContext->headerPrinter) {
+                $this->writeOutput($filePathHeader, $compilationContext->headerPrinter->getOutput());
             }
         }
 
@@ -938,6 +1000,28 @@ final class CompilerFile implements FileInterface
         $this->ir = null;
     }
 
+    /**
+     * Checks if an IR node contains closures.
+     *
+     * @param array $node
+     *
+     * @return bool
+     */
+    private function hasClosures(array $node)
+    {
+        if (isset($node['type']) && ('closure' === $node['type'] || 'closure-arrow' === $node['type'])) {
+            return true;
+        }
+
+        foreach ($node as $child) {
+            if (\is_array($child) && $this->hasClosures($child)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     public function applyClassHeaders(CompilationContext $compilationContext)
     {
         $classDefinition = $this->classDefinition;
@@ -82,6 +82,12 @@ class Config implements \ArrayAccess, \JsonSerializable
             'call-gatherer-pass' => true,
             'check-invalid-reads' => false,
             'internal-call-transformation' => false,
+            'observer-slots' => true,
+            'inline-method-cache' => true,
+            'property-slots' => true,
+            'immutable-default-arrays' => true,
+            'in-array-index' => true,
+            'switch-dispatch' => true,
         ],
         'extra' => [
             'indent' => 'spaces',
@@ -36,6 +36,18 @@ final class BuildCommand extends Command
             ->setDefinition($this->createDefinition())
             ->addOption('dev', null, InputOption::VALUE_NONE, 'Build the extension in development mode')
             ->addOption('no-dev', null, InputOption::VALUE_NONE, 'Build the extension in production mode')
+            ->addOption(
+                'jobs',
+                'j',
+                InputOption::VALUE_REQUIRED,
+                'Number of parallel make jobs (defaults to the number of CPUs)'
+            )
+            ->addOption(
+                'timings',
+                null,
+                InputOption::VALUE_NONE,
+                'Write the CPU time spent compiling each generated file to compile-timings.log'
+            )
             ->setHelp($this->getDevelopmentModeHelp().PHP_EOL.$this->getZflagsHelp());
     }
 
@@ -46,8 +58,13 @@ final class BuildCommand extends Command
         $arguments = [
             'command' => 'install',
             '--dev' => $this->isDevelopmentModeEnabled($input),
+            '--timings' => $input->getOption('timings'),
         ];
 
+        if (null !== $input->getOption('jobs')) {
+            $arguments['--jobs'] = $input->getOption('jobs');
+        }
+
         try {
             return $command->run(new ArrayInput($arguments), $output);
         } catch (\Exception $e) {
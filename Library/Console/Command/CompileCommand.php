@@ -47,6 +47,18 @@ final class CompileCommand extends Command
             ->setDefinition($this->createDefinition())
             ->addOption('dev', null, InputOption::VALUE_NONE, 'Compile the extension in development mode')
             ->addOption('no-dev', null, InputOption::VALUE_NONE, 'Compile the extension in production mode')
+            ->addOption(
+                'jobs',
+                'j',
+                InputOption::VALUE_REQUIRED,
+                'Number of parallel make jobs (defaults to the number of CPUs)'
+            )
+            ->addOption(
+                'timings',
+                null,
+                InputOption::VALUE_NONE,
+                'Write the CPU time spent compiling each generated file to compile-timings.log'
+            )
             ->setHelp($this->getDevelopmentModeHelp().PHP_EOL.$this->getZflagsHelp());
     }
 
@@ -57,7 +69,9 @@ final class CompileCommand extends Command
         try {
             // TODO: Move all the stuff from the compiler
             $this->compiler->compile(
-                $this->isDevelopmentModeEnabled($input)
+                $this->isDevelopmentModeEnabled($input),
+                $input->getOption('jobs'),
+                $input->getOption('timings')
             );
         } catch (CompilerException $e) {
             $io->error($e->getMessage());
@@ -54,7 +54,7 @@ final class GenerateCommand extends Command
 
         try {
             // TODO: Move all the stuff from the compiler
-            $this->compiler->generate(true);
+            $this->compiler->generate(true, max(1, (int) $input->getOption('jobs')));
         } catch (InvalidArgumentException $e) {
             $io->error(
                 sprintf(
@@ -86,6 +86,13 @@ final class GenerateCommand extends Command
                     'Used backend to generate extension',
                     'ZendEngine3'
                 ),
+                new InputOption(
+                    'jobs',
+                    'j',
+                    InputOption::VALUE_REQUIRED,
+                    'Number of processes generating C code in parallel',
+                    1
+                ),
             ]
         );
     }
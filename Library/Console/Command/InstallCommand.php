@@ -50,6 +50,18 @@ final class InstallCommand extends Command
             ->setDescription('Installs the extension in the extension directory (may require root password)')
             ->addOption('dev', null, InputOption::VALUE_NONE, 'Install the extension in development mode')
             ->addOption('no-dev', null, InputOption::VALUE_NONE, 'Install the extension in production mode')
+            ->addOption(
+                'jobs',
+                'j',
+                InputOption::VALUE_REQUIRED,
+                'Number of parallel make jobs (defaults to the number of CPUs)'
+            )
+            ->addOption(
+                'timings',
+                null,
+                InputOption::VALUE_NONE,
+                'Write the CPU time spent compiling each generated file to compile-timings.log'
+            )
             ->setHelp($this->getDevelopmentModeHelp().PHP_EOL.$this->getZflagsHelp());
     }
 
@@ -59,7 +71,9 @@ final class InstallCommand extends Command
 
         try {
             $this->compiler->install(
-                $this->isDevelopmentModeEnabled($input)
+                $this->isDevelopmentModeEnabled($input),
+                $input->getOption('jobs'),
+                $input->getOption('timings')
             );
         } catch (NotImplementedException $e) {
             $io->note($e->getMessage());
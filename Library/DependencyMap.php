@@ -11,14 +11,229 @@
 
 namespace Zephir;
 
+use Zephir\FileSystem\FileSystemInterface;
+
 /**
  * DependencyMap.
  *
- * Manage dependencies between files to perform incremental builds
+ * Manage dependencies between files to perform incremental builds.
+ *
+ * Every class compiled records the classes it looked up in the compiler: parents,
+ * interfaces, called classes and classes whose constants or properties were
+ * referenced. The map is kept in the local cache together with the hash of the
+ * source of each class, so a rebuild only compiles the classes whose source
+ * changed and the classes depending on them.
  */
 class DependencyMap
 {
-    public function addDependency()
+    const CACHE_FILE = 'dependencies.cache';
+
+    /** @var FileSystemInterface */
+    private $filesystem;
+
+    /** @var string */
+    private $signature;
+
+    /**
+     * Records of the previous build, keyed by lowercased class name.
+     *
+     * @var array|null
+     */
+    private $previous;
+
+    /**
+     * Records of the current build, keyed by lowercased class name.
+     *
+     * @var array
+     */
+    private $records = [];
+
+    /**
+     * Lowercased names of the classes changed since the previous build.
+     *
+     * @var array
+     */
+    private $changed = [];
+
+    /**
+     * Classes looked up by the file being compiled.
+     *
+     * @var array|null
+     */
+    private $dependencies;
+
+    /**
+     * DependencyMap constructor.
+     *
+     * @param FileSystemInterface $filesystem
+     * @param string              $signature  Anything that affects the code generated for every class
+     */
+    public function __construct(FileSystemInterface $filesystem, $signature)
+    {
+        $this->filesystem = $filesystem;
+        $this->signature = 'ZEPDEP:'.md5(Zephir::VERSION.'|'.$signature);
+    }
+
+    /**
+     * Records a class looked up by the file being compiled.
+     *
+     * @param string $className
+     */
+    public function addDependency($className)
     {
+        if (null !== $this->dependencies) {
+            $this->dependencies[strtolower(ltrim($className, '\\'))] = true;
+        }
+    }
+
+    /**
+     * Starts recording the dependencies of a file.
+     */
+    public function startRecording()
+    {
+        $this->dependencies = [];
+    }
+
+    /**
+     * Returns the dependencies recorded since startRecording() and stops recording.
+     *
+     * @return string[]
+     */
+    public function stopRecording()
+    {
+        $dependencies = array_keys((array) $this->dependencies);
+        $this->dependencies = null;
+
+        return $dependencies;
+    }
+
+    /**
+     * Computes the classes changed since the previous build.
+     *
+     * A class is changed when its source hash differs, when it is new or when
+     * any of its ancestors changed. Removed classes are changed as well, so
+     * the classes which used them are compiled again.
+     *
+     * @param CompilerFile[] $compileFiles
+     */
+    public function computeChanges(array $compileFiles)
+    {
+        $this->load();
+
+        $this->changed = [];
+        foreach ($this->previous as $className => $record) {
+            $this->changed[$className] = true;
+        }
+
+        $changed = [];
+        foreach ($compileFiles as $compileFile) {
+            $classDefinition = $compileFile->getClassDefinition();
+            $className = strtolower($classDefinition->getCompleteName());
+            unset($this->changed[$className]);
+
+            if (!isset($this->previous[$className]) ||
+                $this->previous[$className]['hash'] !== $compileFile->getSourceHash()) {
+                $changed[] = $classDefinition;
+            }
+        }
+
+        foreach ($compileFiles as $compileFile) {
+            $classDefinition = $compileFile->getClassDefinition();
+            if ($this->hasChangedAncestor($classDefinition, $changed)) {
+                $this->changed[strtolower($classDefinition->getCompleteName())] = true;
+            }
+        }
+    }
+
+    /**
+     * Returns the record of a class from the previous build if it is still valid.
+     *
+     * @param string $className
+     * @param string $hash
+     *
+     * @return array|null
+     */
+    public function getRecord($className, $hash)
+    {
+        $className = strtolower($className);
+        if (isset($this->changed[$className]) || !isset($this->previous[$className])) {
+            return null;
+        }
+
+        $record = $this->previous[$className];
+        if ($record['hash'] !== $hash) {
+            return null;
+        }
+
+        foreach ($record['dependencies'] as $dependency) {
+            if (isset($this->changed[$dependency])) {
+                return null;
+            }
+        }
+
+        return $record;
+    }
+
+    /**
+     * Stores the record of a class for the next build.
+     *
+     * @param string $className
+     * @param array  $record
+     */
+    public function setRecord($className, array $record)
+    {
+        $this->records[strtolower($className)] = $record;
+    }
+
+    /**
+     * Writes the records of the current build.
+     */
+    public function save()
+    {
+        $this->filesystem->write(self::CACHE_FILE, $this->signature."\n".serialize($this->records));
+    }
+
+    private function load()
+    {
+        if (null !== $this->previous) {
+            return;
+        }
+
+        $this->previous = [];
+        if (!$this->filesystem->exists(self::CACHE_FILE)) {
+            return;
+        }
+
+        $contents = $this->filesystem->read(self::CACHE_FILE);
+        $offset = \strlen($this->signature) + 1;
+
+        /* Maps of other versions or configurations are discarded */
+        if (0 === strncmp($contents, $this->signature."\n", $offset)) {
+            $records = unserialize(substr($contents, $offset));
+            if (\is_array($records)) {
+                $this->previous = $records;
+            }
+        }
+    }
+
+    /**
+     * @param ClassDefinition   $classDefinition
+     * @param ClassDefinition[] $changed
+     *
+     * @return bool
+     */
+    private function hasChangedAncestor(ClassDefinition $classDefinition, array $changed)
+    {
+        if (\in_array($classDefinition, $changed, true)) {
+            return true;
+        }
+
+        foreach ($classDefinition->getDependencies() as $dependency) {
+            if ($this->hasChangedAncestor($dependency, $changed)) {
+                return true;
+            }
+        }
+
+        return false;
     }
 }
@@ -97,6 +97,10 @@ class FunctionCall extends Call
             case 'globals_set':
             case 'merge_append':
             case 'get_class_lower':
+            case 'escape_css':
+            case 'escape_js':
+            case 'escape_css_utf8':
+            case 'escape_js_utf8':
                 return true;
         }
 
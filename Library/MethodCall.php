@@ -712,59 +712,47 @@ class MethodCall extends Call
             $realMethod = $this->getRealCalledMethod($compilationContext, $variableVariable, $methodName);
 
             $isInternal = false;
+            $guardClassEntry = null;
             if (\is_object($realMethod[1])) {
-                $realMethod[1] = $realMethod[1]->getOptimizedMethod();
-                $method = $realMethod[1];
-                $isInternal = $realMethod[1]->isInternal();
-                if ($isInternal && $realMethod[0] > 1) {
-                    throw new CompilerException(
-                        "Cannot resolve method: '".$expression['name']."' in polymorphic variable",
-                        $expression
-                    );
+                $optimizedMethod = $realMethod[1]->getOptimizedMethod();
+                if ($optimizedMethod !== $realMethod[1]) {
+                    /*
+                     * The internal copy of a method can be called directly if the class of the receiver
+                     * is resolved. A subclass could override the method, so the call is guarded by the
+                     * class entry and the regular method call remains as fallback
+                     */
+                    if (1 == $realMethod[0] && ('this' == $variableVariable->getRealName() || $realMethod[1]->isPublic())) {
+                        $method = $optimizedMethod;
+                        $isInternal = true;
+                        $guardClassEntry = $realMethod[2]->getClassEntry($compilationContext);
+                    }
+                } else {
+                    $method = $realMethod[1];
+                    $isInternal = $realMethod[1]->isInternal();
+                    if ($isInternal && $realMethod[0] > 1) {
+                        throw new CompilerException(
+                            "Cannot resolve method: '".$expression['name']."' in polymorphic variable",
+                            $expression
+                        );
+                    }
                 }
             }
 
-            if (!$isInternal) {
-                // Check if the method call can have an inline cache
-                $methodCache = $compilationContext->cacheManager->getMethodCache();
-
-                $cachePointer = $methodCache->get(
-                    $compilationContext,
-                    $methodName,
-                    $variableVariable
-                );
-
-                $compilationContext->backend->callMethod(
-                    $isExpecting ? $symbolVariable : null,
-                    $variableVariable,
-                    $methodName,
-                    $cachePointer,
-                    \count($params) ? $params : null,
-                    $compilationContext
-                );
-            } else {
-                //TODO: also move to backend
-                if ($isExpecting) {
-                    $symbolCode = $compilationContext->backend->getVariableCodePointer($symbolVariable);
-                }
+            if ($isInternal && $guardClassEntry) {
                 $variableCode = $compilationContext->backend->getVariableCode($variableVariable);
-                $paramCount = \count($params);
-                $paramsStr = $paramCount ? ', '.implode(', ', $params) : '';
-
-                if ($isExpecting) {
-                    if ('return_value' == $symbolVariable->getName()) {
-                        $macro = $compilationContext->backend->getFcallManager()->getMacro(false, true, $paramCount);
-                        $codePrinter->output($macro.'('.$variableCode.', '.$method->getInternalName().$paramsStr.');');
-                    } else {
-                        $macro = $compilationContext->backend->getFcallManager()->getMacro(false, 2, $paramCount);
-                        $codePrinter->output(
-                            $macro.'('.$symbolCode.', '.$variableCode.', '.$method->getInternalName().$paramsStr.');'
-                        );
-                    }
-                } else {
-                    $macro = $compilationContext->backend->getFcallManager()->getMacro(false, false, $paramCount);
-                    $codePrinter->output($macro.'('.$variableCode.', '.$method->getInternalName().$paramsStr.');');
-                }
+                $codePrinter->output('if (Z_TYPE_P('.$variableCode.') == IS_OBJECT && Z_OBJCE_P('.$variableCode.') == '.$guardClassEntry.') {');
+                $codePrinter->increaseLevel();
+                $this->callInternalMethod($symbolVariable, $variableVariable, $method, $params, $isExpecting, $compilationContext);
+                $codePrinter->decreaseLevel();
+                $codePrinter->output('} else {');
+                $codePrinter->increaseLevel();
+                $this->callMethod($type, $symbolVariable, $variableVariable, $methodName, $params, $isExpecting, $compilationContext);
+                $codePrinter->decreaseLevel();
+                $codePrinter->output('}');
+            } elseif ($isInternal) {
+                $this->callInternalMethod($symbolVariable, $variableVariable, $method, $params, $isExpecting, $compilationContext);
+            } else {
+                $this->callMethod($type, $symbolVariable, $variableVariable, $methodName, $params, $isExpecting, $compilationContext);
             }
         } else {
             if (self::CALL_DYNAMIC == $type) {
@@ -822,7 +810,95 @@ class MethodCall extends Call
     }
 
     /**
-     * Examine internal class information and returns the method called.
+     * Calls a method through the method caches of the call site.
+     *
+     * @param int                $type
+     * @param Variable|null      $symbolVariable
+     * @param Variable           $variableVariable
+     * @param string             $methodName
+     * @param array              $params
+     * @param bool               $isExpecting
+     * @param CompilationContext $compilationContext
+     */
+    private function callMethod($type, $symbolVariable, Variable $variableVariable, $methodName, array $params, $isExpecting, CompilationContext $compilationContext)
+    {
+        // Check if the method call can have an inline cache
+        $methodCache = $compilationContext->cacheManager->getMethodCache();
+
+        // Calls without a static cache slot can be resolved per receiver class
+        $inlineCache = self::CALL_NORMAL == $type &&
+            $compilationContext->backend->isZE3() &&
+            $compilationContext->config->get('inline-method-cache', 'optimizations');
+
+        $cachePointer = $methodCache->get(
+            $compilationContext,
+            $methodName,
+            $variableVariable,
+            $staticSlot,
+            $inlineCache
+        );
+
+        if ($inlineCache && !$staticSlot) {
+            $compilationContext->backend->callMethodInlineCache(
+                $isExpecting ? $symbolVariable : null,
+                $variableVariable,
+                $methodName,
+                $methodCache->getInlineCache($compilationContext),
+                \count($params) ? $params : null,
+                $compilationContext
+            );
+        } else {
+            $compilationContext->backend->callMethod(
+                $isExpecting ? $symbolVariable : null,
+                $variableVariable,
+                $methodName,
+                $cachePointer,
+                \count($params) ? $params : null,
+                $compilationContext
+            );
+        }
+    }
+
+    /**
+     * Calls the C function of an internal method directly.
+     *
+     * @param Variable|null      $symbolVariable
+     * @param Variable           $variableVariable
+     * @param ClassMethod        $method
+     * @param array              $params
+     * @param bool               $isExpecting
+     * @param CompilationContext $compilationContext
+     */
+    private function callInternalMethod($symbolVariable, Variable $variableVariable, ClassMethod $method, array $params, $isExpecting, CompilationContext $compilationContext)
+    {
+        //TODO: also move to backend
+        $codePrinter = $compilationContext->codePrinter;
+        if ($isExpecting) {
+            $symbolCode = $compilationContext->backend->getVariableCodePointer($symbolVariable);
+        }
+        $variableCode = $compilationContext->backend->getVariableCode($variableVariable);
+        $paramCount = \count($params);
+        $paramsStr = $paramCount ? ', '.implode(', ', $params) : '';
+
+        if ($isExpecting) {
+            if ('return_value' == $symbolVariable->getName()) {
+                $macro = $compilationContext->backend->getFcallManager()->getMacro(false, true, $paramCount);
+                $codePrinter->output($macro.'('.$variableCode.', '.$method->getInternalName().$paramsStr.');');
+            } else {
+                $macro = $compilationContext->backend->getFcallManager()->getMacro(false, 2, $paramCount);
+                $codePrinter->output(
+                    $macro.'('.$symbolCode.', '.$variableCode.', '.$method->getInternalName().$paramsStr.');'
+                );
+            }
+        } else {
+            $macro = $compilationContext->backend->getFcallManager()->getMacro(false, false, $paramCount);
+            $codePrinter->output($macro.'('.$variableCode.', '.$method->getInternalName().$paramsStr.');');
+        }
+    }
+
+    /**
+     * Examine internal class information and returns the method called
+     * and the class it was resolved from.
      *
      * @param CompilationContext $compilationContext
      * @param Variable           $caller
@@ -836,12 +912,14 @@ class MethodCall extends Call
 
         $numberPoly = 0;
         $method = null;
+        $receiver = null;
 
         if ('this' == $caller->getRealName()) {
             $classDefinition = $compilationContext->classDefinition;
             if ($classDefinition->hasMethod($methodName)) {
                 ++$numberPoly;
                 $method = $classDefinition->getMethod($methodName);
+                $receiver = $classDefinition;
             }
         } else {
             $classTypes = $caller->getClassTypes();
@@ -867,11 +945,12 @@ class MethodCall extends Call
                     if ($classDefinition->hasMethod($methodName) && !$classDefinition->isInterface()) {
                         ++$numberPoly;
                         $method = $classDefinition->getMethod($methodName);
+                        $receiver = $classDefinition;
                     }
                 }
             }
         }
 
-        return [$numberPoly, $method];
+        return [$numberPoly, $method, $receiver];
     }
 }
@@ -22,5 +22,5 @@ class MulOperator extends ArithmeticalBaseOperator
 
     protected $bitOperator = '+';
 
-    protected $zvalOperator = 'mul_function';
+    protected $zvalOperator = 'zephir_mul_function';
 }
@@ -16,6 +16,7 @@ use Zephir\CompiledExpression;
 use Zephir\Exception\CompilerException;
 use Zephir\Expression;
 use Zephir\Operators\BaseOperator;
+use Zephir\Variable;
 
 /**
  * BaseOperator.
@@ -28,6 +29,17 @@ class ComparisonBaseOperator extends BaseOperator
 
     protected $commutative = false;
 
+    /** Integers up to this magnitude compare the same as longs or as doubles */
+    const MAX_EXACT_DOUBLE_INT = 9007199254740992;
+
+    /**
+     * Whether integers may be compared as doubles with variables holding
+     * doubles, false for operators telling 1 and 1.0 apart.
+     *
+     * @var bool
+     */
+    protected $speculative = true;
+
     /**
      * @param $expr
      * @param CompilationContext $compilationContext
@@ -278,9 +290,8 @@ class ComparisonBaseOperator extends BaseOperator
 
                             case 'variable':
                                 $compilationContext->headersManager->add('kernel/operators');
-                                $variableCode = $compilationContext->backend->getVariableCode($variableRight);
 
-                                return new CompiledExpression('bool', $this->zvalLongNegOperator.'('.$variableCode.', '.$left->getCode().')', $expression);
+                                return new CompiledExpression('bool', $this->getNumericComparison($variableRight, $left, true, $compilationContext), $expression);
 
                             default:
                                 throw new CompilerException('Unknown type: '.$variableRight->getType(), $expression['right']);
@@ -588,7 +599,7 @@ class ComparisonBaseOperator extends BaseOperator
                             case 'double':
                                 $compilationContext->headersManager->add('kernel/operators');
 
-                                return new CompiledExpression('bool', $this->zvalLongOperator.'('.$variableCode.', '.$right->getCode().')', $expression['left']);
+                                return new CompiledExpression('bool', $this->getNumericComparison($variable, $right, false, $compilationContext), $expression['left']);
 
                             case 'char':
                             case 'uchar':
@@ -655,4 +666,39 @@ class ComparisonBaseOperator extends BaseOperator
                 throw new CompilerException('Unknown type: '.$left->getType(), $expression);
         }
     }
+
+    /**
+     * Compares a dynamic variable with a number using the kernel macro whose
+     * inline guard matches the type the variable is expected to hold.
+     *
+     * Doubles use the double macros. Integer literals exactly representable
+     * as doubles are compared as doubles when every value assigned to the
+     * variable so far was a double, anything else uses the long macros. The
+     * macros fall back to compare_function() for other types.
+     *
+     * @param Variable           $variable
+     * @param CompiledExpression $number
+     * @param bool               $negated  Whether the variable is the right operand
+     * @param CompilationContext $compilationContext
+     *
+     * @return string
+     */
+    protected function getNumericComparison(Variable $variable, CompiledExpression $number, $negated, CompilationContext $compilationContext)
+    {
+        $variableCode = $compilationContext->backend->getVariableCode($variable);
+        $longOperator = $negated ? $this->zvalLongNegOperator : $this->zvalLongOperator;
+        $doubleOperator = $negated ? $this->zvalDoubleNegOperator : $this->zvalDoubleOperator;
+        $code = $number->getCode();
+
+        if ('double' == $number->getType()) {
+            return $doubleOperator.'('.$variableCode.', '.$code.')';
+        }
+
+        if ($this->speculative && ['double' => true] === $variable->getDynamicTypes() &&
+            preg_match('/^-?\d+$/', $code) && abs((float) $code) < self::MAX_EXACT_DOUBLE_INT) {
+            return $doubleOperator.'('.$variableCode.', (double) '.$code.')';
+        }
+
+        return $longOperator.'('.$variableCode.', '.$code.')';
+    }
 }
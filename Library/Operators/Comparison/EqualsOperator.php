@@ -25,6 +25,10 @@ class EqualsOperator extends ComparisonBaseOperator
 
     protected $zvalLongNegOperator = 'ZEPHIR_IS_LONG';
 
+    protected $zvalDoubleOperator = 'ZEPHIR_IS_DOUBLE';
+
+    protected $zvalDoubleNegOperator = 'ZEPHIR_IS_DOUBLE';
+
     protected $zvalStringOperator = 'ZEPHIR_IS_STRING';
 
     protected $zvalBoolOperator = 'ZEPHIR_IS_BOOL_VALUE';
@@ -15,6 +15,8 @@ class IdenticalOperator extends ComparisonBaseOperator
 {
     protected $commutative = true;
 
+    protected $speculative = false;
+
     protected $operator = '==';
 
     protected $bitOperator = '==';
@@ -25,6 +27,10 @@ class IdenticalOperator extends ComparisonBaseOperator
 
     protected $zvalLongNegOperator = 'ZEPHIR_IS_LONG_IDENTICAL';
 
+    protected $zvalDoubleOperator = 'ZEPHIR_IS_DOUBLE_IDENTICAL';
+
+    protected $zvalDoubleNegOperator = 'ZEPHIR_IS_DOUBLE_IDENTICAL';
+
     protected $zvalStringOperator = 'ZEPHIR_IS_STRING_IDENTICAL';
 
     protected $zvalBoolOperator = 'ZEPHIR_IS_BOOL_IDENTICAL';
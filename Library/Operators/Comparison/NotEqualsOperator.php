@@ -29,6 +29,8 @@ class NotEqualsOperator extends ComparisonBaseOperator
 
     protected $zvalDoubleOperator = '!ZEPHIR_IS_DOUBLE';
 
+    protected $zvalDoubleNegOperator = '!ZEPHIR_IS_DOUBLE';
+
     protected $zvalStringOperator = '!ZEPHIR_IS_STRING';
 
     protected $zvalBoolOperator = '!ZEPHIR_IS_BOOL_VALUE';
@@ -153,6 +153,13 @@ class ConcatOperator extends BaseOperator
         $key = '';
         $concatParts = [];
         $parts = array_reverse($parts);
+
+        /*
+         * Scalar operands are passed unboxed to the concat function, which formats them
+         * into the destination string (ZendEngine3 only)
+         */
+        $scalarOperands = $compilationContext->backend->isZE3();
+
         foreach ($parts as $part) {
             $expr = new Expression($part);
             $expr->setStringOperation(true);
@@ -185,12 +192,43 @@ class ConcatOperator extends BaseOperator
 
                         case 'int':
                         case 'long':
+                            if ($scalarOperands) {
+                                $key .= 'l';
+                                $concatParts[] = $variable->getName();
+                                break;
+                            }
                             $key .= 'v';
                             $tempVariable = $compilationContext->symbolTable->getTempLocalVariableForWrite('variable', $compilationContext, $originalExpr);
                             $compilationContext->backend->assignLong($tempVariable, $compiledExpr->getCode(), $compilationContext);
                             $concatParts[] = $compilationContext->backend->getVariableCode($tempVariable);
                             break;
 
+                        case 'uint':
+                        case 'ulong':
+                            if (!$scalarOperands) {
+                                throw new CompilerException('Variable type: '.$variable->getType().' cannot be used in concat operation', $compiledExpr->getOriginal());
+                            }
+                            $key .= 'u';
+                            $concatParts[] = '(zend_ulong) '.$variable->getName();
+                            break;
+
+                        case 'double':
+                            if (!$scalarOperands) {
+                                throw new CompilerException('Variable type: '.$variable->getType().' cannot be used in concat operation', $compiledExpr->getOriginal());
+                            }
+                            $key .= 'd';
+                            $concatParts[] = $variable->getName();
+                            break;
+
+                        case 'char':
+                        case 'uchar':
+                            if (!$scalarOperands) {
+                                throw new CompilerException('Variable type: '.$variable->getType().' cannot be used in concat operation', $compiledExpr->getOriginal());
+                            }
+                            $key .= 'c';
+                            $concatParts[] = $variable->getName();
+                            break;
+
                         default:
                             throw new CompilerException('Variable type: '.$variable->getType().' cannot be used in concat operation', $compiledExpr->getOriginal());
                     }
@@ -203,12 +241,34 @@ class ConcatOperator extends BaseOperator
 
                 case 'int':
                 case 'long':
+                    if ($scalarOperands) {
+                        $key .= 'l';
+                        $concatParts[] = $compiledExpr->getCode();
+                        break;
+                    }
                     $key .= 'v';
                     $tempVariable = $compilationContext->symbolTable->getTempLocalVariableForWrite('variable', $compilationContext, $originalExpr);
                     $compilationContext->codePrinter->output('ZVAL_LONG(&'.$tempVariable->getName().', '.$compiledExpr->getCode().');');
                     $concatParts[] = '&'.$tempVariable->getName();
                     break;
 
+                case 'double':
+                    if (!$scalarOperands) {
+                        throw new CompilerException('Variable type: '.$compiledExpr->getType().' cannot be used in concat operation', $compiledExpr->getOriginal());
+                    }
+                    $key .= 'd';
+                    $concatParts[] = $compiledExpr->getCode();
+                    break;
+
+                case 'char':
+                case 'uchar':
+                    if (!$scalarOperands) {
+                        throw new CompilerException('Variable type: '.$compiledExpr->getType().' cannot be used in concat operation', $compiledExpr->getOriginal());
+                    }
+                    $key .= 'c';
+                    $concatParts[] = '\''.$compiledExpr->getCode().'\'';
+                    break;
+
                 default:
                     throw new CompilerException('Variable type: '.$compiledExpr->getType().' cannot be used in concat operation', $compiledExpr->getOriginal());
             }
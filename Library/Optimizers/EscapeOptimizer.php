@@ -0,0 +1,82 @@
+<?php
+
+/*
+ * This file is part of the Zephir.
+ *
+ * (c) Zephir Team <team@zephir-lang.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code.
+ */
+
+namespace Zephir\Optimizers;
+
+use Zephir\Call;
+use Zephir\CompilationContext;
+use Zephir\CompiledExpression;
+use Zephir\Exception\CompilerException;
+
+/**
+ * Class EscapeOptimizer.
+ *
+ * Base of the optimizers calling the CSS/JS escape functions of the kernel
+ */
+abstract class EscapeOptimizer extends OptimizerAbstract
+{
+    /**
+     * Gets the name of the function in the optimized code.
+     *
+     * @return string
+     */
+    abstract public function getFunctionName();
+
+    /**
+     * Gets the name of the kernel function called by the optimized code.
+     *
+     * @return string
+     */
+    abstract public function getKernelFunctionName();
+
+    /**
+     * @param array              $expression
+     * @param Call               $call
+     * @param CompilationContext $context
+     *
+     * @throws CompilerException
+     *
+     * @return bool|CompiledExpression|mixed
+     */
+    public function optimize(array $expression, Call $call, CompilationContext $context)
+    {
+        if (!isset($expression['parameters'])) {
+            return false;
+        }
+
+        if (1 != \count($expression['parameters'])) {
+            throw new CompilerException("'".$this->getFunctionName()."' only accepts one parameter", $expression);
+        }
+
+        /*
+         * Process the expected symbol to be returned
+         */
+        $call->processExpectedReturn($context);
+
+        $symbolVariable = $call->getSymbolVariable(true, $context);
+        if ($symbolVariable->isNotVariableAndString()) {
+            throw new CompilerException('Returned values by functions can only be assigned to variant variables', $expression);
+        }
+
+        $context->headersManager->add('kernel/filter');
+
+        $resolvedParams = $call->getReadOnlyResolvedParams($expression['parameters'], $context, $expression);
+
+        if ($call->mustInitSymbolVariable()) {
+            $symbolVariable->initVariant($context);
+        }
+
+        $symbol = $context->backend->getVariableCode($symbolVariable);
+        $context->codePrinter->output($this->getKernelFunctionName().'('.$symbol.', '.$resolvedParams[0].');');
+
+        return new CompiledExpression('variable', $symbolVariable->getRealName(), $expression);
+    }
+}
@@ -0,0 +1,75 @@
+<?php
+
+/*
+ * This file is part of the Zephir.
+ *
+ * (c) Zephir Team <team@zephir-lang.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code.
+ */
+
+namespace Zephir\Optimizers\FunctionCall;
+
+use Zephir\Call;
+use Zephir\CompilationContext;
+use Zephir\CompiledExpression;
+use Zephir\Exception\CompilerException;
+use Zephir\Optimizers\OptimizerAbstract;
+
+/**
+ * ArraySumOptimizer.
+ *
+ * Optimizes calls to 'array_sum' of integer ranges using internal function
+ */
+class ArraySumOptimizer extends OptimizerAbstract
+{
+    /**
+     * @param array              $expression
+     * @param Call               $call
+     * @param CompilationContext $context
+     *
+     * @throws CompilerException
+     *
+     * @return bool|CompiledExpression|mixed
+     */
+    public function optimize(array $expression, Call $call, CompilationContext $context)
+    {
+        if (!isset($expression['parameters'])) {
+            return false;
+        }
+
+        if (1 != \count($expression['parameters'])) {
+            return false;
+        }
+
+        /*
+         * array_sum(a..b) of integer bounds is computed without building the range
+         */
+        $bounds = $this->getIntegerRangeBounds($expression['parameters'][0]['parameter'], $context);
+        if (!$bounds) {
+            return false;
+        }
+
+        /*
+         * Process the expected symbol to be returned
+         */
+        $call->processExpectedReturn($context);
+
+        $symbolVariable = $call->getSymbolVariable(true, $context);
+        if ($symbolVariable->isNotVariableAndString()) {
+            throw new CompilerException('Returned values by functions can only be assigned to variant variables', $expression);
+        }
+
+        $context->headersManager->add('kernel/array');
+        $symbolVariable->setDynamicTypes(['long', 'double']);
+
+        if ($call->mustInitSymbolVariable()) {
+            $symbolVariable->initVariant($context);
+        }
+        $symbol = $context->backend->getVariableCode($symbolVariable);
+        $context->codePrinter->output('zephir_range_sum('.$symbol.', '.$bounds[0].', '.$bounds[1].');');
+
+        return new CompiledExpression('variable', $symbolVariable->getRealName(), $expression);
+    }
+}
@@ -40,6 +40,16 @@ class CountOptimizer extends OptimizerAbstract
             return false;
         }
 
+        /*
+         * count(a..b) of integer bounds is computed without building the range
+         */
+        $bounds = $this->getIntegerRangeBounds($expression['parameters'][0]['parameter'], $context);
+        if ($bounds) {
+            $context->headersManager->add('kernel/array');
+
+            return new CompiledExpression('int', 'ZEPHIR_RANGE_COUNT('.$bounds[0].', '.$bounds[1].')', $expression);
+        }
+
         $resolvedParams = $call->getReadOnlyResolvedParams($expression['parameters'], $context, $expression);
 
         return new CompiledExpression('int', 'zephir_fast_count_int('.$resolvedParams[0].' TSRMLS_CC)', $expression);
@@ -74,7 +74,12 @@ class CreateInstanceOptimizer extends OptimizerAbstract
         $call->addCallStatusFlag($context);
 
         $symbol = $context->backend->getVariableCode($symbolVariable);
-        $context->codePrinter->output('ZEPHIR_LAST_CALL_STATUS = zephir_create_instance('.$symbol.', '.$resolvedParams[0].' TSRMLS_CC);');
+        $instanceCache = $this->getInstanceCache($context);
+        if ($instanceCache) {
+            $context->codePrinter->output('ZEPHIR_LAST_CALL_STATUS = ZEPHIR_CREATE_INSTANCE_IC('.$symbol.', '.$resolvedParams[0].', '.$instanceCache.');');
+        } else {
+            $context->codePrinter->output('ZEPHIR_LAST_CALL_STATUS = zephir_create_instance('.$symbol.', '.$resolvedParams[0].' TSRMLS_CC);');
+        }
 
         $call->checkTempParameters($context);
         $call->addCallStatusOrJump($context);
@@ -69,7 +69,12 @@ class CreateInstanceParamsOptimizer extends OptimizerAbstract
         $call->addCallStatusFlag($context);
 
         $symbol = $context->backend->getVariableCode($symbolVariable);
-        $context->codePrinter->output('ZEPHIR_LAST_CALL_STATUS = zephir_create_instance_params('.$symbol.', '.$resolvedParams[0].', '.$resolvedParams[1].' TSRMLS_CC);');
+        $instanceCache = $this->getInstanceCache($context);
+        if ($instanceCache) {
+            $context->codePrinter->output('ZEPHIR_LAST_CALL_STATUS = ZEPHIR_CREATE_INSTANCE_PARAMS_IC('.$symbol.', '.$resolvedParams[0].', '.$resolvedParams[1].', '.$instanceCache.');');
+        } else {
+            $context->codePrinter->output('ZEPHIR_LAST_CALL_STATUS = zephir_create_instance_params('.$symbol.', '.$resolvedParams[0].', '.$resolvedParams[1].' TSRMLS_CC);');
+        }
 
         $call->addCallStatusOrJump($context);
 
@@ -0,0 +1,32 @@
+<?php
+
+/*
+ * This file is part of the Zephir.
+ *
+ * (c) Zephir Team <team@zephir-lang.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code.
+ */
+
+namespace Zephir\Optimizers\FunctionCall;
+
+use Zephir\Optimizers\EscapeOptimizer;
+
+/**
+ * EscapeCssOptimizer.
+ *
+ * Optimizes calls to 'escape_css' using internal function
+ */
+class EscapeCssOptimizer extends EscapeOptimizer
+{
+    public function getFunctionName()
+    {
+        return 'escape_css';
+    }
+
+    public function getKernelFunctionName()
+    {
+        return 'zephir_escape_css';
+    }
+}
@@ -0,0 +1,32 @@
+<?php
+
+/*
+ * This file is part of the Zephir.
+ *
+ * (c) Zephir Team <team@zephir-lang.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code.
+ */
+
+namespace Zephir\Optimizers\FunctionCall;
+
+use Zephir\Optimizers\EscapeOptimizer;
+
+/**
+ * EscapeJsUtf8Optimizer.
+ *
+ * Optimizes calls to 'escape_js_utf8' using internal function
+ */
+class EscapeJsUtf8Optimizer extends EscapeOptimizer
+{
+    public function getFunctionName()
+    {
+        return 'escape_js_utf8';
+    }
+
+    public function getKernelFunctionName()
+    {
+        return 'zephir_escape_js_utf8';
+    }
+}
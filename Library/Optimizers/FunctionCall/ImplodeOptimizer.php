@@ -54,6 +54,30 @@ class ImplodeOptimizer extends OptimizerAbstract
             throw new CompilerException('Returned values by functions can only be assigned to variant variables', $expression);
         }
 
+        /*
+         * join(glue, explode(delimiter, str)) replaces the delimiters in place
+         */
+        $pieces = $expression['parameters'][1]['parameter'];
+        if ('fcall' == $pieces['type'] && 'explode' == $pieces['name'] && isset($pieces['parameters']) && 2 == \count($pieces['parameters'])) {
+            $resolvedParams = $call->getReadOnlyResolvedParams(
+                [$expression['parameters'][0], $pieces['parameters'][0], $pieces['parameters'][1]],
+                $context,
+                $expression
+            );
+
+            $context->headersManager->add('kernel/string');
+            $symbolVariable->setDynamicTypes('string');
+
+            if ($call->mustInitSymbolVariable()) {
+                $symbolVariable->initVariant($context);
+            }
+
+            $symbol = $context->backend->getVariableCode($symbolVariable);
+            $context->codePrinter->output('zephir_fast_join_split('.$symbol.', '.implode(', ', $resolvedParams).');');
+
+            return new CompiledExpression('variable', $symbolVariable->getRealName(), $expression);
+        }
+
         if ('string' == $expression['parameters'][0]['parameter']['type']) {
             $str = add_slashes($expression['parameters'][0]['parameter']['value']);
             unset($expression['parameters'][0]);
@@ -14,13 +14,15 @@ namespace Zephir\Optimizers\FunctionCall;
 use Zephir\Call;
 use Zephir\CompilationContext;
 use Zephir\CompiledExpression;
+use Zephir\Detectors\WriteDetector;
 use Zephir\Exception\CompilerException;
 use Zephir\Optimizers\OptimizerAbstract;
 
 /**
  * InArrayOptimizer.
  *
- * Optimizes calls to 'in_array' using internal function
+ * Optimizes calls to 'in_array' using internal function. Haystacks not assigned
+ * inside the loop calling 'in_array' are indexed once for the whole loop.
  */
 class InArrayOptimizer extends OptimizerAbstract
 {
@@ -39,14 +41,96 @@ class InArrayOptimizer extends OptimizerAbstract
             return false;
         }
 
-        if (2 != \count($expression['parameters'])) {
+        $parameters = $expression['parameters'];
+        if (2 != \count($parameters) && 3 != \count($parameters)) {
             return false;
         }
 
+        /* Only a literal $strict can be known at compile time */
+        $strict = false;
+        if (isset($parameters[2])) {
+            if ('bool' != $parameters[2]['parameter']['type']) {
+                return false;
+            }
+
+            $strict = 'true' == $parameters[2]['parameter']['value'];
+            unset($parameters[2]);
+        }
+
         $context->headersManager->add('kernel/array');
 
-        $resolvedParams = $call->getReadOnlyResolvedParams($expression['parameters'], $context, $expression);
+        /*
+         * An integer is in a..b of integer bounds when it lies between them,
+         * whether compared strictly or not
+         */
+        if ($this->isIntegerOperand($parameters[0]['parameter'], $context)) {
+            $bounds = $this->getIntegerRangeBounds($parameters[1]['parameter'], $context);
+            if ($bounds) {
+                $needle = $this->getIntegerOperand($parameters[0]['parameter'], $context);
+
+                return new CompiledExpression('bool', 'ZEPHIR_RANGE_CONTAINS('.$needle.', '.$bounds[0].', '.$bounds[1].')', $expression);
+            }
+        }
+
+        $resolvedParams = $call->getReadOnlyResolvedParams($parameters, $context, $expression);
+
+        if ($this->isLoopInvariant($parameters[1]['parameter'], $context)) {
+            $index = $context->symbolTable->addTemp('variable', $context);
+
+            $context->headersManager->add('kernel/memory');
+            $context->symbolTable->mustGrownStack(true);
+            $context->codePrinter->output('ZEPHIR_OBS_VAR_ONCE('.$context->backend->getVariableCode($index).');');
+
+            return new CompiledExpression(
+                'bool',
+                'zephir_fast_in_array_indexed('.$context->backend->getVariableCode($index).', '.$resolvedParams[0].', '.$resolvedParams[1].', '.($strict ? 1 : 0).')',
+                $expression
+            );
+        }
+
+        if ($strict) {
+            return new CompiledExpression('bool', 'zephir_fast_in_array_strict('.$resolvedParams[0].', '.$resolvedParams[1].')', $expression);
+        }
 
         return new CompiledExpression('bool', 'zephir_fast_in_array('.$resolvedParams[0].', '.$resolvedParams[1].' TSRMLS_CC)', $expression);
     }
+
+    /**
+     * Whether the haystack is a variable not assigned in the innermost loop,
+     * so it is worth indexing once for the whole loop.
+     *
+     * @param array              $haystack
+     * @param CompilationContext $context
+     *
+     * @return bool
+     */
+    private function isLoopInvariant(array $haystack, CompilationContext $context)
+    {
+        if (!$context->insideCycle || !\count($context->cycleBlocks)) {
+            return false;
+        }
+
+        if (!$context->config->get('in-array-index', 'optimizations')) {
+            return false;
+        }
+
+        if ('variable' != $haystack['type'] || 'this' == $haystack['value']) {
+            return false;
+        }
+
+        $variable = $context->symbolTable->getVariable($haystack['value']);
+        if (!$variable || !\in_array($variable->getType(), ['variable', 'array'], true)) {
+            return false;
+        }
+
+        /*
+         * Arguments of calls do not count as writes here: in_array() itself
+         * takes the haystack, and the kernel notices a haystack separated by
+         * any other write
+         */
+        $currentBlock = $context->cycleBlocks[\count($context->cycleBlocks) - 1];
+        $detector = new WriteDetector();
+
+        return !$detector->detect($haystack['value'], $currentBlock->getStatements());
+    }
 }
@@ -56,13 +56,28 @@ class Md5Optimizer extends OptimizerAbstract
         $context->headersManager->add('kernel/string');
         $symbolVariable->setDynamicTypes('string');
 
-        $resolvedParams = $call->getReadOnlyResolvedParams($expression['parameters'], $context, $expression);
+        /*
+         * md5(file_get_contents(filename)) reads the file in chunks and
+         * md5(unique_key(prefix, value)) hashes the key without building it
+         */
+        $kernel = 'zephir_md5';
+        $parameters = $expression['parameters'];
+        $contents = $parameters[0]['parameter'];
+        if ('fcall' == $contents['type'] && 'file_get_contents' == $contents['name'] && isset($contents['parameters']) && 1 == \count($contents['parameters'])) {
+            $kernel = 'zephir_md5_file';
+            $parameters = $contents['parameters'];
+        } elseif ('fcall' == $contents['type'] && 'unique_key' == $contents['name'] && isset($contents['parameters']) && 2 == \count($contents['parameters'])) {
+            $kernel = 'zephir_md5_unique_key';
+            $parameters = $contents['parameters'];
+        }
+
+        $resolvedParams = $call->getReadOnlyResolvedParams($parameters, $context, $expression);
 
         if ($call->mustInitSymbolVariable()) {
             $symbolVariable->initVariant($context);
         }
         $symbol = $context->backend->getVariableCode($symbolVariable);
-        $context->codePrinter->output('zephir_md5('.$symbol.', '.$resolvedParams[0].');');
+        $context->codePrinter->output($kernel.'('.$symbol.', '.implode(', ', $resolvedParams).');');
 
         return new CompiledExpression('variable', $symbolVariable->getRealName(), $expression);
     }
@@ -80,28 +80,50 @@ class PregMatchOptimizer extends OptimizerAbstract
         // zephir_preg_match
         $context->headersManager->add('kernel/string');
 
+        /*
+         * Literal patterns are compiled once per call site
+         */
+        $pattern = $expression['parameters'][0]['parameter'];
+        $literal = 'string' === $pattern['type'];
+
         try {
-            $resolvedParams = $call->getReadOnlyResolvedParams($expression['parameters'], $context, $expression);
+            $parameters = $literal ? [$expression['parameters'][1]] : [$expression['parameters'][0], $expression['parameters'][1]];
+            $resolvedParams = $call->getReadOnlyResolvedParams($parameters, $context, $expression);
 
             if ($call->mustInitSymbolVariable()) {
                 $symbolVariable->initVariant($context);
             }
 
             $symbol = $context->backend->getVariableCode($symbolVariable);
-            $matchesSymbol = $context->backend->getVariableCode($matches);
+            $matchesSymbol = $matches ? $context->backend->getVariableCode($matches) : 'NULL';
 
-            $context->codePrinter->output(
-                sprintf(
-                    'zephir_preg_match(%s, %s, %s, %s, %d, %s, %s TSRMLS_CC);',
-                    $symbol,
-                    $resolvedParams[0],
-                    $resolvedParams[1],
-                    $matchesSymbol,
-                    static::GLOBAL_MATCH,
-                    $flags,
-                    $offset
-                )
-            );
+            if ($literal) {
+                $context->codePrinter->output(
+                    sprintf(
+                        'zephir_preg_match_literal(%s, "%s", %s, %s, %d, %s, %s);',
+                        $symbol,
+                        str_replace(PHP_EOL, '\\n', $pattern['value']),
+                        $resolvedParams[0],
+                        $matchesSymbol,
+                        static::GLOBAL_MATCH,
+                        $flags,
+                        $offset
+                    )
+                );
+            } else {
+                $context->codePrinter->output(
+                    sprintf(
+                        'zephir_preg_match(%s, %s, %s, %s, %d, %s, %s TSRMLS_CC);',
+                        $symbol,
+                        $resolvedParams[0],
+                        $resolvedParams[1],
+                        $matchesSymbol,
+                        static::GLOBAL_MATCH,
+                        $flags,
+                        $offset
+                    )
+                );
+            }
 
             return new CompiledExpression('variable', $symbolVariable->getRealName(), $expression);
         } catch (Exception $e) {
@@ -127,7 +149,6 @@ class PregMatchOptimizer extends OptimizerAbstract
         $flags = null;
         $offset = null;
 
-        $offsetParamOffset = 4;
         if (isset($expression['parameters'][4]) && 'int' === $expression['parameters'][4]['parameter']['type']) {
             $offset = $expression['parameters'][4]['parameter']['value'].' ';
             unset($expression['parameters'][4]);
@@ -135,24 +156,29 @@ class PregMatchOptimizer extends OptimizerAbstract
 
         if (isset($expression['parameters'][3]) && 'int' === $expression['parameters'][3]['parameter']['type']) {
             $flags = $expression['parameters'][3]['parameter']['value'].' ';
-            $offsetParamOffset = 3;
             unset($expression['parameters'][3]);
         }
 
-        try {
-            $resolvedParams = $call->getReadOnlyResolvedParams($expression['parameters'], $context, $expression);
-
-            if (null === $offset && isset($resolvedParams[$offsetParamOffset])) {
-                $context->headersManager->add('kernel/operators');
-                $offset = 'zephir_get_intval('.$resolvedParams[$offsetParamOffset].') ';
+        $optionals = array_intersect_key($expression['parameters'], [3 => true, 4 => true]);
+        if ($optionals) {
+            try {
+                $resolvedParams = array_combine(
+                    array_keys($optionals),
+                    $call->getReadOnlyResolvedParams(array_values($optionals), $context, $expression)
+                );
+            } catch (Exception $e) {
+                throw new CompilerException($e->getMessage(), $expression, $e->getCode(), $e);
             }
 
-            if (null === $flags && isset($resolvedParams[3])) {
-                $context->headersManager->add('kernel/operators');
+            $context->headersManager->add('kernel/operators');
+
+            if (isset($resolvedParams[3])) {
                 $flags = 'zephir_get_intval('.$resolvedParams[3].') ';
             }
-        } catch (Exception $e) {
-            throw new CompilerException($e->getMessage(), $expression, $e->getCode(), $e);
+
+            if (isset($resolvedParams[4])) {
+                $offset = 'zephir_get_intval('.$resolvedParams[4].') ';
+            }
         }
 
         if (null === $flags) {
@@ -174,7 +200,7 @@ class PregMatchOptimizer extends OptimizerAbstract
      * @param array              $expression
      * @param CompilationContext $context
      *
-     * @return Variable
+     * @return Variable|null
      */
     private function createMatches(array $expression, CompilationContext $context)
     {
@@ -209,13 +235,14 @@ class PregMatchOptimizer extends OptimizerAbstract
                 $variable->initVariant($context);
                 $variable->setIsInitialized(true, $context);
             }
-        } else {
-            $variable = $context->symbolTable->addTemp('variable', $context);
-            $variable->initVariant($context);
-        }
 
-        $variable->setDynamicTypes('array');
+            $variable->increaseUses();
+            $variable->setDynamicTypes('array');
+
+            return $variable;
+        }
 
-        return $variable;
+        /* Without matches no match array is built at all */
+        return null;
     }
 }
@@ -27,4 +27,88 @@ abstract class OptimizerAbstract
      * @return mixed
      */
     abstract public function optimize(array $expression, Call $call, CompilationContext $context);
+
+    /**
+     * Returns the per call site cache used by create_instance() and
+     * create_instance_params(), or null when the inline caches are disabled.
+     *
+     * @param CompilationContext $context
+     *
+     * @return string|null
+     */
+    protected function getInstanceCache(CompilationContext $context)
+    {
+        if (!$context->backend->isZE3() || !$context->config->get('inline-method-cache', 'optimizations')) {
+            return null;
+        }
+
+        $instanceCache = $context->symbolTable->addTemp('zephir_instance_ic', $context);
+        $instanceCache->setReusable(false);
+
+        return '&'.$instanceCache->getName();
+    }
+
+    /**
+     * Returns the C code of the bounds of an 'a..b' or 'a...b' expression when
+     * both are integer literals or int/long variables, so the range can be
+     * handled arithmetically instead of building it with range().
+     *
+     * @param array              $expression
+     * @param CompilationContext $context
+     *
+     * @return string[]|null
+     */
+    protected function getIntegerRangeBounds(array $expression, CompilationContext $context)
+    {
+        if ('irange' != $expression['type'] && 'erange' != $expression['type']) {
+            return null;
+        }
+
+        if (!$this->isIntegerOperand($expression['left'], $context) || !$this->isIntegerOperand($expression['right'], $context)) {
+            return null;
+        }
+
+        return [
+            $this->getIntegerOperand($expression['left'], $context),
+            $this->getIntegerOperand($expression['right'], $context),
+        ];
+    }
+
+    /**
+     * Whether an expression is an integer literal or an int/long variable.
+     *
+     * @param array              $expression
+     * @param CompilationContext $context
+     *
+     * @return bool
+     */
+    protected function isIntegerOperand(array $expression, CompilationContext $context)
+    {
+        switch ($expression['type']) {
+            case 'int':
+                return true;
+
+            case 'variable':
+                $variable = $context->symbolTable->getVariable($expression['value'], $context);
+
+                return $variable && \in_array($variable->getType(), ['int', 'long'], true);
+        }
+
+        return false;
+    }
+
+    /**
+     * @param array              $expression
+     * @param CompilationContext $context
+     *
+     * @return string
+     */
+    protected function getIntegerOperand(array $expression, CompilationContext $context)
+    {
+        if ('int' == $expression['type']) {
+            return $expression['value'];
+        }
+
+        return $context->symbolTable->getVariableForRead($expression['value'], $context, $expression)->getName();
+    }
 }
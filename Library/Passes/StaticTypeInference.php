@@ -11,6 +11,7 @@
 
 namespace Zephir\Passes;
 
+use Zephir\FunctionCall;
 use Zephir\StatementsBlock;
 
 /**
@@ -21,6 +22,29 @@ use Zephir\StatementsBlock;
  */
 class StaticTypeInference
 {
+    /**
+     * Builtin functions returning a known type, with the numbers of arguments
+     * their optimizers compile to that type.
+     */
+    const BUILTIN_RETURN_TYPES = [
+        'count' => ['int', [1]],
+        'strlen' => ['int', [1]],
+        'func_num_args' => ['int', [0]],
+        'intval' => ['long', [1]],
+        'doubleval' => ['double', [1]],
+        'floor' => ['double', [1]],
+        'ceil' => ['double', [1]],
+        'array_key_exists' => ['bool', [2]],
+        'in_array' => ['bool', [2, 3]],
+        'is_numeric' => ['bool', [1]],
+        'is_scalar' => ['bool', [1]],
+        'is_callable' => ['bool', [1]],
+        'starts_with' => ['bool', [2, 3]],
+        'ends_with' => ['bool', [2, 3]],
+        'memstr' => ['bool', [2]],
+        'hash_equals' => ['bool', [2]],
+    ];
+
     protected $variables = [];
 
     protected $infered = [];
@@ -402,8 +426,12 @@ class StaticTypeInference
 
                 return 'bool';
 
-            case 'mcall':
             case 'fcall':
+                $this->passCall($expression);
+
+                return $this->getBuiltinReturnType($expression);
+
+            case 'mcall':
             case 'scall':
                 $this->passCall($expression);
 
@@ -609,4 +637,28 @@ class StaticTypeInference
             }
         }
     }
+
+    /**
+     * Returns the type of a call to a builtin function compiled to a native type.
+     *
+     * @param array $expression
+     *
+     * @return string
+     */
+    protected function getBuiltinReturnType(array $expression)
+    {
+        if (FunctionCall::CALL_NORMAL != $expression['call-type']) {
+            return 'undefined';
+        }
+
+        $name = strtolower($expression['name']);
+        if (!isset(self::BUILTIN_RETURN_TYPES[$name])) {
+            return 'undefined';
+        }
+
+        list($type, $arities) = self::BUILTIN_RETURN_TYPES[$name];
+        $arity = isset($expression['parameters']) ? \count($expression['parameters']) : 0;
+
+        return \in_array($arity, $arities, true) ? $type : 'undefined';
+    }
 }
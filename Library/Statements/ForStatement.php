@@ -392,6 +392,116 @@ class ForStatement extends StatementAbstract
         $codePrinter->output('}');
     }
 
+    /**
+     * Compiles a 'for' statement over 'a..b' or 'a...b' whose bounds are integer
+     * literals or int/long variables. It walks the values range(a, b) holds, in
+     * either direction, without building the array.
+     *
+     * @param array              $exprRaw
+     * @param CompilationContext $compilationContext
+     *
+     * @return bool
+     */
+    public function compileIntegerRange(array $exprRaw, CompilationContext $compilationContext)
+    {
+        $symbolTable = $compilationContext->symbolTable;
+
+        foreach ([$exprRaw['left'], $exprRaw['right']] as $bound) {
+            if ('variable' == $bound['type']) {
+                $variable = $symbolTable->getVariable($bound['value'], $compilationContext);
+                if (!$variable || !\in_array($variable->getType(), ['int', 'long'], true)) {
+                    return false;
+                }
+            } elseif ('int' != $bound['type']) {
+                return false;
+            }
+        }
+
+        $bounds = [];
+        foreach ([$exprRaw['left'], $exprRaw['right']] as $bound) {
+            if ('int' == $bound['type']) {
+                $bounds[] = $bound['value'];
+            } else {
+                $bounds[] = $symbolTable->getVariableForRead($bound['value'], $compilationContext, $bound)->getName();
+            }
+        }
+
+        if ($this->statement['reverse']) {
+            $bounds = array_reverse($bounds);
+        }
+
+        $codePrinter = $compilationContext->codePrinter;
+
+        $currentVariable = $symbolTable->addTemp('long', $compilationContext)->getName();
+        $endVariable = $symbolTable->addTemp('long', $compilationContext)->getName();
+        $stepVariable = $symbolTable->addTemp('long', $compilationContext)->getName();
+        $flagVariable = $symbolTable->addTemp('bool', $compilationContext)->getName();
+
+        /*
+         * The bounds are copied, so the loop does not see them changed
+         */
+        $codePrinter->output($currentVariable.' = '.$bounds[0].';');
+        $codePrinter->output($endVariable.' = '.$bounds[1].';');
+        $codePrinter->output($stepVariable.' = '.$currentVariable.' <= '.$endVariable.' ? 1 : -1;');
+        $codePrinter->output($flagVariable.' = 0;');
+
+        /*
+         * Keys are the ones of the array range(a, b) returns, also when reversed
+         */
+        if (isset($this->statement['key'])) {
+            $keyVariable = $symbolTable->addTemp('long', $compilationContext)->getName();
+            if ($this->statement['reverse']) {
+                $codePrinter->output($keyVariable.' = '.$stepVariable.' * ('.$endVariable.' - '.$currentVariable.');');
+            } else {
+                $codePrinter->output($keyVariable.' = 0;');
+            }
+        }
+
+        ++$compilationContext->insideCycle;
+
+        $codePrinter->output('while (1) {');
+        $codePrinter->increaseLevel();
+
+        $codePrinter->output('if ('.$flagVariable.') {');
+        $codePrinter->increaseLevel();
+        $codePrinter->output('if ('.$currentVariable.' == '.$endVariable.') {');
+        $codePrinter->output("\t".'break;');
+        $codePrinter->output('}');
+        $codePrinter->output($currentVariable.' += '.$stepVariable.';');
+        if (isset($this->statement['key'])) {
+            $codePrinter->output($keyVariable.($this->statement['reverse'] ? '--;' : '++;'));
+        }
+        $codePrinter->decreaseLevel();
+        $codePrinter->output('} else {');
+        $codePrinter->output("\t".$flagVariable.' = 1;');
+        $codePrinter->output('}');
+
+        if (isset($this->statement['key']) && '_' != $this->statement['key']) {
+            $this->compileLoopAssignment($this->statement['key'], $keyVariable, $compilationContext);
+        }
+
+        if (isset($this->statement['value']) && '_' != $this->statement['value']) {
+            $this->compileLoopAssignment($this->statement['value'], $currentVariable, $compilationContext);
+        }
+
+        if (isset($this->statement['statements'])) {
+            $st = new StatementsBlock($this->statement['statements']);
+            $st->isLoop(true);
+            if (isset($this->statement['key'])) {
+                $st->getMutateGatherer()->increaseMutations($this->statement['key']);
+            }
+            $st->getMutateGatherer()->increaseMutations($this->statement['value']);
+            $st->compile($compilationContext);
+        }
+
+        --$compilationContext->insideCycle;
+
+        $codePrinter->decreaseLevel();
+        $codePrinter->output('}');
+
+        return true;
+    }
+
     /**
      * Compiles a 'for' statement that use an 'iterator' as expression.
      *
@@ -518,6 +628,112 @@ class ForStatement extends StatementAbstract
         $compilationContext->backend->destroyIterator($iteratorVariable, $compilationContext);
     }
 
+    /**
+     * Compiles a 'for' statement over 'explode' walking the pieces of the string
+     * one by one instead of building the array of all of them.
+     *
+     * @param array              $exprRaw
+     * @param CompilationContext $compilationContext
+     *
+     * @return bool
+     */
+    public function compileSplit(array $exprRaw, CompilationContext $compilationContext)
+    {
+        if (!isset($exprRaw['parameters']) || 2 != \count($exprRaw['parameters'])) {
+            return false;
+        }
+
+        if ($this->statement['reverse'] || isset($this->statement['key'])) {
+            return false;
+        }
+
+        if (!isset($this->statement['value']) || '_' == $this->statement['value']) {
+            return false;
+        }
+
+        foreach ($exprRaw['parameters'] as $parameter) {
+            switch ($parameter['parameter']['type']) {
+                case 'string':
+                    break;
+
+                case 'variable':
+                    $exprVariable = $compilationContext->symbolTable->getVariable($parameter['parameter']['value'], $compilationContext);
+                    if (!$exprVariable || !\in_array($exprVariable->getType(), ['variable', 'string'], true)) {
+                        return false;
+                    }
+                    break;
+
+                default:
+                    return false;
+            }
+        }
+
+        $variable = $compilationContext->symbolTable->getVariableForWrite($this->statement['value'], $compilationContext, $this->statement['expr']);
+        if ('variable' != $variable->getType()) {
+            return false;
+        }
+
+        $variable->setMustInitNull(true);
+        $variable->setIsInitialized(true, $compilationContext);
+        $variable->setDynamicTypes('string');
+
+        $codePrinter = $compilationContext->codePrinter;
+        $compilationContext->headersManager->add('kernel/string');
+        $compilationContext->headersManager->add('kernel/operators');
+        $compilationContext->symbolTable->mustGrownStack(true);
+
+        /*
+         * The delimiter and the string are kept in their own variables, so the
+         * loop can reassign the original ones
+         */
+        $strings = [];
+        foreach ($exprRaw['parameters'] as $position => $parameter) {
+            $parameter = $parameter['parameter'];
+            $stringVariable = $compilationContext->symbolTable->addTemp('variable', $compilationContext);
+
+            if ('string' == $parameter['type']) {
+                $stringVariable->initVariant($compilationContext);
+                $compilationContext->backend->assignString($stringVariable, add_slashes($parameter['value']), $compilationContext);
+            } else {
+                $exprVariable = $compilationContext->symbolTable->getVariableForRead($parameter['value'], $compilationContext, $exprRaw);
+                $codePrinter->output('zephir_get_strval('.$compilationContext->backend->getVariableCode($stringVariable).', '.$compilationContext->backend->getVariableCode($exprVariable).');');
+            }
+
+            $strings[$position] = $compilationContext->backend->getVariableCode($stringVariable);
+        }
+
+        $offsetVariable = $compilationContext->symbolTable->addTemp('long', $compilationContext);
+        $offset = $offsetVariable->getName();
+
+        /*
+         * Variables are initialized in a different way inside cycle
+         */
+        ++$compilationContext->insideCycle;
+
+        $codePrinter->output('for ('.$offset.' = zephir_split_start('.$strings[1].', '.$strings[0].'); '.$offset.' >= 0; ) {');
+        $codePrinter->increaseLevel();
+        $variable->initVariant($compilationContext);
+        $codePrinter->output($offset.' = zephir_split_next('.$compilationContext->backend->getVariableCode($variable).', '.$strings[1].', '.$strings[0].', '.$offset.');');
+        $codePrinter->decreaseLevel();
+
+        /*
+         * Compile statements in the 'for' block
+         */
+        if (isset($this->statement['statements'])) {
+            $st = new StatementsBlock($this->statement['statements']);
+            $st->isLoop(true);
+            $st->getMutateGatherer()->increaseMutations($this->statement['value']);
+            $st->compile($compilationContext);
+        }
+
+        /*
+         * Restore the cycle counter
+         */
+        --$compilationContext->insideCycle;
+
+        $codePrinter->output('}');
+    }
+
     /**
      * Compiles traversing of string values
      * - Evaluated expression must be a string
@@ -756,6 +972,12 @@ class ForStatement extends StatementAbstract
     {
         $exprRaw = $this->statement['expr'];
 
+        if ('irange' == $exprRaw['type'] || 'erange' == $exprRaw['type']) {
+            if (false !== $this->compileIntegerRange($exprRaw, $compilationContext)) {
+                return;
+            }
+        }
+
         /*
          * @TODO implement optimizers here
          */
@@ -773,6 +995,13 @@ class ForStatement extends StatementAbstract
                     return;
                 }
             }
+
+            if ('explode' == $exprRaw['name']) {
+                $status = $this->compileSplit($exprRaw, $compilationContext);
+                if (false !== $status) {
+                    return;
+                }
+            }
         }
 
         $expr = new Expression($exprRaw);
@@ -807,4 +1036,37 @@ class ForStatement extends StatementAbstract
                 throw new CompilerException('Cannot traverse value type: '.$exprVariable->getType(), $exprRaw);
         }
     }
+
+    /**
+     * Assigns a native temporary variable to the key or value variable of the loop.
+     *
+     * @param string             $variable
+     * @param string             $source
+     * @param CompilationContext $compilationContext
+     */
+    private function compileLoopAssignment($variable, $source, CompilationContext $compilationContext)
+    {
+        $statement = new LetStatement([
+            'type' => 'let',
+            'assignments' => [
+                [
+                    'assign-type' => 'variable',
+                    'variable' => $variable,
+                    'operator' => 'assign',
+                    'expr' => [
+                        'type' => 'variable',
+                        'value' => $source,
+                        'file' => $this->statement['file'],
+                        'line' => $this->statement['line'],
+                        'char' => $this->statement['char'],
+                    ],
+                    'file' => $this->statement['file'],
+                    'line' => $this->statement['line'],
+                    'char' => $this->statement['char'],
+                ],
+            ],
+        ]);
+
+        $statement->compile($compilationContext);
+    }
 }
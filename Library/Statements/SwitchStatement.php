@@ -12,10 +12,13 @@
 namespace Zephir\Statements;
 
 use Zephir\Branch;
+use Zephir\CodePrinter;
 use Zephir\CompilationContext;
+use Zephir\Detectors\WriteDetector;
 use Zephir\Expression;
 use Zephir\Optimizers\EvalExpression;
 use Zephir\StatementsBlock;
+use Zephir\Variable;
 
 /**
  * SwitchStatement.
@@ -24,6 +27,11 @@ use Zephir\StatementsBlock;
  */
 class SwitchStatement extends StatementAbstract
 {
+    /**
+     * Fewest labels worth mapping a zval to its block before the C switch.
+     */
+    const DISPATCH_MIN_LABELS = 4;
+
     /**
      * @param CompilationContext $compilationContext
      */
@@ -113,6 +121,16 @@ class SwitchStatement extends StatementAbstract
                 }
             }
 
+            if ($this->compileDispatch($tempVariable, $blocks, $defaultBlock, $compilationContext)) {
+                $compilationContext->codePrinter->decreaseLevel();
+                --$compilationContext->insideSwitch;
+
+                $codePrinter->output('} while(0);');
+                $codePrinter->outputBlankLine();
+
+                return;
+            }
+
             /*
              * In the second round we generate the conditions with their blocks
              * grouping 'cases' without a statement block using an 'or'
@@ -157,6 +175,324 @@ class SwitchStatement extends StatementAbstract
         }
     }
 
+    /**
+     * Compiles the clauses to a C switch when every label is a distinct
+     * integer, char or string literal. Integer subjects are switched on
+     * directly. A zval is first mapped to the index of its block: longs by
+     * a switch on their value, strings by their length and a byte telling the
+     * labels apart, then memcmp(). Any other type takes the usual comparisons.
+     *
+     * A block falling off its end checks the following labels and runs the
+     * default block, so such blocks are only allowed without a default block
+     * and when they do not change the subject.
+     *
+     * @param Variable           $subject
+     * @param array              $blocks
+     * @param array|null         $defaultBlock
+     * @param CompilationContext $compilationContext
+     *
+     * @return bool false when the clauses must be compiled to an 'if' chain
+     */
+    private function compileDispatch(Variable $subject, array $blocks, $defaultBlock, CompilationContext $compilationContext)
+    {
+        if (!\count($blocks) || !$compilationContext->config->get('switch-dispatch', 'optimizations')) {
+            return false;
+        }
+
+        $labels = $this->getDispatchLabels($blocks);
+        if (!$labels) {
+            return false;
+        }
+
+        $kind = $labels[0]['kind'];
+        $native = \in_array($subject->getType(), ['int', 'uint', 'long', 'ulong', 'char', 'uchar'], true);
+        if ($native) {
+            if ('long' != $kind) {
+                return false;
+            }
+        } elseif ('variable' == $subject->getType() || ('string' == $subject->getType() && 'string' == $kind)) {
+            if (\count($labels) < self::DISPATCH_MIN_LABELS) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+
+        $detector = new WriteDetector();
+        foreach ($blocks as $block) {
+            if ($this->canFallOff($block['block'])) {
+                if ($defaultBlock || $detector->detect($subject->getName(), $block['block'])) {
+                    return false;
+                }
+            }
+        }
+
+        $codePrinter = $compilationContext->codePrinter;
+
+        if ($native) {
+            $codePrinter->output('switch ('.$subject->getName().') {');
+            foreach ($blocks as $index => $block) {
+                foreach ($labels as $label) {
+                    if ($label['block'] == $index) {
+                        $codePrinter->output('case '.$label['code'].':');
+                    }
+                }
+                $this->compileDispatchBlock($block['block'], $compilationContext);
+            }
+        } else {
+            $index = $compilationContext->symbolTable->addTemp('int', $compilationContext)->getName();
+            $subjectCode = $compilationContext->backend->getVariableCode($subject);
+
+            /*
+             * Values of other types are compared as the 'if' chain does
+             */
+            $evalExpr = new EvalExpression();
+            $conditions = [];
+            foreach ($blocks as $block) {
+                $orConditions = [];
+                foreach ($block['expr'] as $expression) {
+                    $orConditions[] = $evalExpr->optimize($expression, $compilationContext);
+                }
+                $conditions[] = implode(' || ', $orConditions);
+            }
+
+            $codePrinter->output($index.' = -1;');
+            if ('long' == $kind) {
+                $codePrinter->output('if (Z_TYPE_P('.$subjectCode.') == IS_LONG) {');
+                $codePrinter->increaseLevel();
+                $codePrinter->output('switch (Z_LVAL_P('.$subjectCode.')) {');
+                foreach ($blocks as $blockIndex => $block) {
+                    foreach ($labels as $label) {
+                        if ($label['block'] == $blockIndex) {
+                            $codePrinter->output('case '.$label['code'].':');
+                        }
+                    }
+                    $codePrinter->increaseLevel();
+                    $codePrinter->output($index.' = '.$blockIndex.';');
+                    $codePrinter->output('break;');
+                    $codePrinter->decreaseLevel();
+                }
+                $codePrinter->output('}');
+                $codePrinter->decreaseLevel();
+            } else {
+                $codePrinter->output('if (Z_TYPE_P('.$subjectCode.') == IS_STRING) {');
+                $codePrinter->increaseLevel();
+                $this->compileStringDispatch($subjectCode, $index, $labels, $codePrinter);
+                $codePrinter->decreaseLevel();
+            }
+
+            foreach ($conditions as $blockIndex => $condition) {
+                $codePrinter->output('} else if ('.$condition.') {');
+                $codePrinter->increaseLevel();
+                $codePrinter->output($index.' = '.$blockIndex.';');
+                $codePrinter->decreaseLevel();
+            }
+            $codePrinter->output('}');
+
+            $codePrinter->output('switch ('.$index.') {');
+            foreach ($blocks as $blockIndex => $block) {
+                $codePrinter->output('case '.$blockIndex.':');
+                $this->compileDispatchBlock($block['block'], $compilationContext);
+            }
+        }
+
+        if ($defaultBlock) {
+            $codePrinter->output('default:');
+            $codePrinter->increaseLevel();
+            $st = new StatementsBlock($defaultBlock);
+            $st->compile($compilationContext);
+            $codePrinter->output('break;');
+            $codePrinter->decreaseLevel();
+        }
+
+        $codePrinter->output('}');
+
+        return true;
+    }
+
+    /**
+     * Returns the labels of the blocks when all of them are distinct literals
+     * of the same kind: integers and chars ('long') or strings ('string').
+     *
+     * @param array $blocks
+     *
+     * @return array|null
+     */
+    private function getDispatchLabels(array $blocks)
+    {
+        $labels = [];
+        $keys = [];
+        foreach ($blocks as $index => $block) {
+            foreach ($block['expr'] as $expression) {
+                $label = $expression['right'];
+                switch ($label['type']) {
+                    case 'int':
+                        if (!preg_match('/^-?(0|[1-9][0-9]*)$/', $label['value'])) {
+                            return null;
+                        }
+                        $key = (int) $label['value'];
+                        $labels[] = ['kind' => 'long', 'code' => $label['value'], 'block' => $index];
+                        break;
+
+                    case 'char':
+                        $key = \ord(stripcslashes($label['value']));
+                        $labels[] = ['kind' => 'long', 'code' => "'".$label['value']."'", 'block' => $index];
+                        break;
+
+                    case 'string':
+                        /*
+                         * Only escapes decoded the same by C and stripcslashes()
+                         */
+                        if (preg_match('/\\\\[^ntr"\'\\\\]/', $label['value'])) {
+                            return null;
+                        }
+                        $key = stripcslashes($label['value']);
+                        $labels[] = [
+                            'kind' => 'string',
+                            'code' => str_replace(PHP_EOL, '\\n', $label['value']),
+                            'bytes' => $key,
+                            'block' => $index,
+                        ];
+                        break;
+
+                    default:
+                        return null;
+                }
+
+                $key = \gettype($key).':'.$key;
+                if (isset($keys[$key])) {
+                    return null;
+                }
+                $keys[$key] = true;
+            }
+        }
+
+        foreach ($labels as $label) {
+            if ($label['kind'] != $labels[0]['kind']) {
+                return null;
+            }
+        }
+
+        return $labels;
+    }
+
+    /**
+     * Maps a string to the index of its block by length and by the byte most
+     * of the labels of that length differ in.
+     *
+     * @param string             $subjectCode
+     * @param string             $index
+     * @param array              $labels
+     * @param CodePrinter        $codePrinter
+     */
+    private function compileStringDispatch($subjectCode, $index, array $labels, CodePrinter $codePrinter)
+    {
+        $lengths = [];
+        foreach ($labels as $label) {
+            $lengths[\strlen($label['bytes'])][] = $label;
+        }
+        ksort($lengths);
+
+        $codePrinter->output('switch (Z_STRLEN_P('.$subjectCode.')) {');
+        foreach ($lengths as $length => $group) {
+            $codePrinter->output('case '.$length.':');
+            $codePrinter->increaseLevel();
+
+            if (0 == $length) {
+                $codePrinter->output($index.' = '.$group[0]['block'].';');
+            } elseif (1 == \count($group)) {
+                $this->compileStringCompare($subjectCode, $index, $group, $codePrinter);
+            } else {
+                $position = 0;
+                $best = 0;
+                for ($i = 0; $i < $length; ++$i) {
+                    $bytes = [];
+                    foreach ($group as $label) {
+                        $bytes[$label['bytes'][$i]] = true;
+                    }
+                    if (\count($bytes) > $best) {
+                        $position = $i;
+                        $best = \count($bytes);
+                    }
+                }
+
+                $buckets = [];
+                foreach ($group as $label) {
+                    $buckets[\ord($label['bytes'][$position])][] = $label;
+                }
+                ksort($buckets);
+
+                $codePrinter->output('switch ((unsigned char) Z_STRVAL_P('.$subjectCode.')['.$position.']) {');
+                foreach ($buckets as $byte => $bucket) {
+                    $codePrinter->output('case '.(ctype_alnum(\chr($byte)) ? "'".\chr($byte)."'" : $byte).':');
+                    $codePrinter->increaseLevel();
+                    $this->compileStringCompare($subjectCode, $index, $bucket, $codePrinter);
+                    $codePrinter->output('break;');
+                    $codePrinter->decreaseLevel();
+                }
+                $codePrinter->output('}');
+            }
+
+            $codePrinter->output('break;');
+            $codePrinter->decreaseLevel();
+        }
+        $codePrinter->output('}');
+    }
+
+    /**
+     * @param string             $subjectCode
+     * @param string             $index
+     * @param array              $labels      Labels of the same length
+     * @param CodePrinter        $codePrinter
+     */
+    private function compileStringCompare($subjectCode, $index, array $labels, CodePrinter $codePrinter)
+    {
+        foreach ($labels as $i => $label) {
+            $condition = '!memcmp(Z_STRVAL_P('.$subjectCode.'), "'.$label['code'].'", '.\strlen($label['bytes']).')';
+            $codePrinter->output(($i ? '} else if (' : 'if (').$condition.') {');
+            $codePrinter->increaseLevel();
+            $codePrinter->output($index.' = '.$label['block'].';');
+            $codePrinter->decreaseLevel();
+        }
+        $codePrinter->output('}');
+    }
+
+    /**
+     * @param array              $statements
+     * @param CompilationContext $compilationContext
+     */
+    private function compileDispatchBlock(array $statements, CompilationContext $compilationContext)
+    {
+        $codePrinter = $compilationContext->codePrinter;
+
+        $codePrinter->increaseLevel();
+        $st = new StatementsBlock($statements);
+        $branch = $st->compile($compilationContext, false, Branch::TYPE_SWITCH);
+        $branch->setRelatedStatement($this);
+        if ($this->canFallOff($statements)) {
+            $codePrinter->output('break;');
+        }
+        $codePrinter->decreaseLevel();
+    }
+
+    /**
+     * Whether execution may reach the end of a case block.
+     *
+     * @param array $statements
+     *
+     * @return bool
+     */
+    private function canFallOff(array $statements)
+    {
+        if (!\count($statements)) {
+            return true;
+        }
+
+        $last = end($statements);
+
+        return !\in_array($last['type'], ['break', 'continue', 'return', 'throw'], true);
+    }
+
     public function normalizeClauses($clauses)
     {
         foreach ($clauses as $defaultIndex => $clause) {
@@ -469,7 +469,8 @@ class StaticCall extends Call
             $symbolVariable->trackVariant($compilationContext);
         }
 
-        if ($method) {
+        /* Only methods visible from the calling scope are called directly */
+        if ($method && ($method->isPublic() || $classDefinition === $compilationContext->classDefinition)) {
             $method = $method->getOptimizedMethod();
         }
 
@@ -222,6 +222,40 @@ function is_bsd()
     return false !== stripos(PHP_OS, 'BSD');
 }
 
+/**
+ * Returns the number of online processors, or 1 if it cannot be detected.
+ *
+ * @return int
+ */
+function cpu_count()
+{
+    if (is_windows()) {
+        $count = (int) getenv('NUMBER_OF_PROCESSORS');
+    } elseif (is_macos() || is_bsd()) {
+        $count = (int) shell_exec('sysctl -n hw.ncpu 2>/dev/null');
+    } else {
+        $count = (int) shell_exec('nproc 2>/dev/null');
+        if ($count < 1 && is_readable('/proc/cpuinfo')) {
+            $count = preg_match_all('/^processor\s*:/m', file_get_contents('/proc/cpuinfo'));
+        }
+    }
+
+    return max(1, $count);
+}
+
+/**
+ * Returns the number of parallel make jobs for a --jobs option, which
+ * defaults to the number of CPUs.
+ *
+ * @param int|string|null $jobs
+ *
+ * @return int
+ */
+function make_jobs($jobs)
+{
+    return $jobs ? max(1, (int) $jobs) : cpu_count();
+}
+
 /**
  * Checks if current PHP is thread safe.
  *
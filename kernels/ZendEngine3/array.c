@@ -128,7 +128,7 @@ int zephir_array_isset_fetch(zval *fetched, const zval *arr, zval *index, int re
 
 		case IS_LONG:
 		case IS_RESOURCE:
-			result = zend_hash_index_find(h, Z_LVAL_P(index));
+			result = zephir_hash_index_find(h, Z_LVAL_P(index));
 			break;
 
 		case IS_TRUE:
@@ -225,7 +225,7 @@ int zephir_array_isset_long_fetch(zval *fetched, const zval *arr, unsigned long
 
 		return 0;
 	} else if (EXPECTED(Z_TYPE_P(arr) == IS_ARRAY)) {
-		if ((zv = zend_hash_index_find(Z_ARRVAL_P(arr), index)) != NULL) {
+		if ((zv = zephir_hash_index_find(Z_ARRVAL_P(arr), index)) != NULL) {
 			zephir_ensure_array(zv);
 
 			if (!readonly) {
@@ -324,7 +324,7 @@ int ZEPHIR_FASTCALL zephir_array_isset_long(const zval *arr, unsigned long index
 
 		return 0;
 	} else if (EXPECTED(Z_TYPE_P(arr) == IS_ARRAY)) {
-		return zend_hash_index_exists(Z_ARRVAL_P(arr), index);
+		return zephir_hash_index_find(Z_ARRVAL_P(arr), index) != NULL;
 	}
 
 	return 0;
@@ -476,7 +476,7 @@ int zephir_array_fetch(zval *return_value, zval *arr, zval *index, int flags ZEP
 			case IS_LONG:
 			case IS_RESOURCE:
 				uidx   = Z_LVAL_P(index);
-				found  = (zv = zend_hash_index_find(ht, uidx)) != NULL;
+				found  = (zv = zephir_hash_index_find(ht, uidx)) != NULL;
 				break;
 
 			case IS_FALSE:
@@ -574,7 +574,20 @@ int zephir_array_fetch_long(zval *return_value, zval *arr, unsigned long index,
 {
 	zval *zv;
 
-	if (UNEXPECTED(Z_TYPE_P(arr) == IS_OBJECT && zephir_instance_of_ev(arr, (const zend_class_entry *)zend_ce_arrayaccess))) {
+	if (EXPECTED(Z_TYPE_P(arr) == IS_ARRAY)) {
+		if ((zv = zephir_hash_index_find(Z_ARRVAL_P(arr), index)) != NULL) {
+
+			if ((flags & PH_READONLY) == PH_READONLY) {
+				ZVAL_COPY_VALUE(return_value, zv);
+			} else {
+				ZVAL_COPY(return_value, zv);
+			}
+			return SUCCESS;
+		}
+		if ((flags & PH_NOISY) == PH_NOISY) {
+			zend_error(E_NOTICE, "Undefined index: %lu", index);
+		}
+	} else if (UNEXPECTED(Z_TYPE_P(arr) == IS_OBJECT && zephir_instance_of_ev(arr, (const zend_class_entry *)zend_ce_arrayaccess))) {
 		zend_long ZEPHIR_LAST_CALL_STATUS;
 		zval offset;
 		ZVAL_LONG(&offset, index);
@@ -587,19 +600,6 @@ int zephir_array_fetch_long(zval *return_value, zval *arr, unsigned long index,
 		}
 
 		return FAILURE;
-	} else if (EXPECTED(Z_TYPE_P(arr) == IS_ARRAY)) {
-		if ((zv = zend_hash_index_find(Z_ARRVAL_P(arr), index)) != NULL) {
-
-			if ((flags & PH_READONLY) == PH_READONLY) {
-				ZVAL_COPY_VALUE(return_value, zv);
-			} else {
-				ZVAL_COPY(return_value, zv);
-			}
-			return SUCCESS;
-		}
-		if ((flags & PH_NOISY) == PH_NOISY) {
-			zend_error(E_NOTICE, "Undefined index: %lu", index);
-		}
 	} else {
 		if ((flags & PH_NOISY) == PH_NOISY) {
 			zend_error(E_NOTICE, "Cannot use a scalar value as an array in %s on line %d", file, line);
@@ -1038,6 +1038,212 @@ int zephir_fast_in_array(zval *value, zval *haystack)
 	return 0;
 }
 
+/**
+ * Fast in_array function with strict comparison
+ */
+int zephir_fast_in_array_strict(zval *value, zval *haystack)
+{
+	zval *entry;
+
+	if (Z_TYPE_P(haystack) != IS_ARRAY) {
+		return 0;
+	}
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(haystack), entry) {
+		ZVAL_DEREF(entry);
+		if (fast_is_identical_function(value, entry)) {
+			return 1;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	return 0;
+}
+
+/* Types of the values found in an indexed haystack */
+#define ZEPHIR_IN_ARRAY_STRINGS 1
+#define ZEPHIR_IN_ARRAY_NUMERIC 2
+#define ZEPHIR_IN_ARRAY_LONGS   4
+#define ZEPHIR_IN_ARRAY_OTHERS  8
+#define ZEPHIR_IN_ARRAY_REFS    16
+
+/* Smaller haystacks are scanned, they are not worth an index */
+#define ZEPHIR_IN_ARRAY_INDEX_MIN 8
+
+static void zephir_in_array_build_index(zval *index, zval *haystack)
+{
+	zval set, *entry;
+	zend_long types = 0;
+
+	array_init_size(&set, zend_hash_num_elements(Z_ARRVAL_P(haystack)));
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(haystack), entry) {
+		switch (Z_TYPE_P(entry)) {
+			case IS_STRING:
+				types |= ZEPHIR_IN_ARRAY_STRINGS;
+				if (!(types & ZEPHIR_IN_ARRAY_NUMERIC) && is_numeric_string(Z_STRVAL_P(entry), Z_STRLEN_P(entry), NULL, NULL, 0)) {
+					types |= ZEPHIR_IN_ARRAY_NUMERIC;
+				}
+				/* Not a symtable: numeric strings and integers stay apart */
+				zend_hash_add_empty_element(Z_ARRVAL(set), Z_STR_P(entry));
+				break;
+
+			case IS_LONG:
+				types |= ZEPHIR_IN_ARRAY_LONGS;
+				zend_hash_index_add_empty_element(Z_ARRVAL(set), Z_LVAL_P(entry));
+				break;
+
+			/* Referenced values change without writing to the haystack */
+			case IS_REFERENCE:
+				types |= ZEPHIR_IN_ARRAY_REFS;
+				break;
+
+			default:
+				types |= ZEPHIR_IN_ARRAY_OTHERS;
+				break;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	/**
+	 * The index keeps a reference to the haystack it was built for, so
+	 * any write to the haystack separates it from the indexed one
+	 */
+	zval_ptr_dtor(index);
+	array_init_size(index, 3);
+	Z_TRY_ADDREF_P(haystack);
+	add_next_index_zval(index, haystack);
+	add_next_index_zval(index, &set);
+	add_next_index_long(index, types);
+}
+
+/**
+ * in_array() for haystacks tested many times, e.g. inside a loop. The values
+ * of the haystack are indexed in index on the first call, later calls look
+ * the needle up in the index for as long as the haystack is the same array.
+ * Lookups the index cannot answer with the comparison semantics of
+ * in_array() scan the haystack. index must be UNDEF or NULL the first time.
+ */
+int zephir_fast_in_array_indexed(zval *index, zval *value, zval *haystack, int strict)
+{
+	zval *indexed, *set, *types;
+	zend_long found_types;
+
+	if (Z_TYPE_P(index) == IS_UNDEF) {
+		ZVAL_NULL(index);
+	}
+
+	ZVAL_DEREF(haystack);
+	if (Z_TYPE_P(haystack) != IS_ARRAY) {
+		return 0;
+	}
+
+	if (zend_hash_num_elements(Z_ARRVAL_P(haystack)) < ZEPHIR_IN_ARRAY_INDEX_MIN) {
+		return strict ? zephir_fast_in_array_strict(value, haystack) : zephir_fast_in_array(value, haystack);
+	}
+
+	if (Z_TYPE_P(index) != IS_ARRAY || Z_ARRVAL_P(zend_hash_index_find(Z_ARRVAL_P(index), 0)) != Z_ARRVAL_P(haystack)) {
+		zephir_in_array_build_index(index, haystack);
+	}
+
+	indexed = zend_hash_index_find(Z_ARRVAL_P(index), 0);
+	set = zend_hash_index_find(Z_ARRVAL_P(index), 1);
+	types = zend_hash_index_find(Z_ARRVAL_P(index), 2);
+	found_types = Z_LVAL_P(types);
+
+	ZVAL_DEREF(value);
+	if (found_types & ZEPHIR_IN_ARRAY_REFS) {
+		return strict ? zephir_fast_in_array_strict(value, indexed) : zephir_fast_in_array(value, indexed);
+	}
+
+	if (strict) {
+		/* Identical strings and integers are always found in the index */
+		switch (Z_TYPE_P(value)) {
+			case IS_STRING:
+				return zend_hash_exists(Z_ARRVAL_P(set), Z_STR_P(value));
+
+			case IS_LONG:
+				return zend_hash_index_exists(Z_ARRVAL_P(set), Z_LVAL_P(value));
+		}
+
+		return zephir_fast_in_array_strict(value, indexed);
+	}
+
+	switch (Z_TYPE_P(value)) {
+		case IS_STRING:
+			/**
+			 * Integers and other types loosely equal many strings, but two
+			 * strings are only equal with different contents when both are
+			 * numeric
+			 */
+			if (found_types & (ZEPHIR_IN_ARRAY_LONGS | ZEPHIR_IN_ARRAY_OTHERS)) {
+				break;
+			}
+
+			if (zend_hash_exists(Z_ARRVAL_P(set), Z_STR_P(value))) {
+				return 1;
+			}
+
+			if (!(found_types & ZEPHIR_IN_ARRAY_NUMERIC) || !is_numeric_string(Z_STRVAL_P(value), Z_STRLEN_P(value), NULL, NULL, 0)) {
+				return 0;
+			}
+			break;
+
+		case IS_LONG:
+			if (found_types & (ZEPHIR_IN_ARRAY_STRINGS | ZEPHIR_IN_ARRAY_OTHERS)) {
+				break;
+			}
+
+			return zend_hash_index_exists(Z_ARRVAL_P(set), Z_LVAL_P(value));
+	}
+
+	return zephir_fast_in_array(value, indexed);
+}
+
+/**
+ * array_sum(range(low, high)) of integer bounds in closed form. A sum that does
+ * not fit a long is a float PHP accumulates element by element, so the range is
+ * built in that case
+ */
+void zephir_range_sum(zval *return_value, zend_long low, zend_long high)
+{
+	zend_long first = low <= high ? low : high, last = low <= high ? high : low;
+	zend_long sum = 0;
+	double dsum;
+	int overflow = 1;
+
+	/* Both the number of elements and first + last have to fit a long */
+	if ((first >= 0 ? last - first < ZEND_LONG_MAX : last < ZEND_LONG_MAX + first) &&
+		(last <= 0 || first <= ZEND_LONG_MAX - last) && (last >= 0 || first >= ZEND_LONG_MIN - last)) {
+		zend_long count = last - first + 1, total = first + last;
+
+		/* With an odd number of elements first and last have the same parity */
+		if (count % 2 == 0) {
+			ZEND_SIGNED_MULTIPLY_LONG(count / 2, total, sum, dsum, overflow);
+		} else {
+			ZEND_SIGNED_MULTIPLY_LONG(count, total / 2, sum, dsum, overflow);
+		}
+	}
+
+	if (!overflow) {
+		RETURN_LONG(sum);
+	}
+
+	{
+		zval range, bounds[2];
+		zval *range_params[2] = { &bounds[0], &bounds[1] };
+		zval *sum_params[1] = { &range };
+
+		ZVAL_LONG(&bounds[0], low);
+		ZVAL_LONG(&bounds[1], high);
+		ZVAL_NULL(&range);
+
+		if (zephir_call_func_aparams(&range, SL("range"), NULL, 0, 2, range_params) == SUCCESS) {
+			zephir_call_func_aparams(return_value, SL("array_sum"), NULL, 0, 1, sum_params);
+		}
+
+		zval_ptr_dtor(&range);
+	}
+}
+
 /**
  * Fast array merge
  */
@@ -1067,3 +1273,57 @@ void zephir_fast_array_merge(zval *return_value, zval *array1, zval *array2)
 
 	php_array_merge(Z_ARRVAL_P(return_value), Z_ARRVAL_P(array2));
 }
+
+#if PHP_VERSION_ID >= 70300
+/**
+ * Initializes a persistent array to be filled at module startup and sealed
+ * with zephir_persistent_array_seal(). Such arrays live as long as the process
+ * and may only contain scalars, interned strings and other sealed arrays.
+ */
+void zephir_persistent_array_init(zval *arr, uint32_t size)
+{
+	HashTable *ht = pemalloc(sizeof(HashTable), 1);
+
+	zend_hash_init(ht, size, NULL, NULL, 1);
+	ZVAL_ARR(arr, ht);
+}
+
+void zephir_persistent_array_append(zval *arr, zval *value)
+{
+	zend_hash_next_index_insert(Z_ARRVAL_P(arr), value);
+}
+
+void zephir_persistent_array_update_string(zval *arr, const char *index, size_t index_length, zval *value)
+{
+	zend_string *key = zend_new_interned_string(zend_string_init(index, index_length, 1));
+
+	zend_symtable_update(Z_ARRVAL_P(arr), key, value);
+}
+
+void zephir_persistent_array_update_long(zval *arr, zend_long index, zval *value)
+{
+	zend_hash_index_update(Z_ARRVAL_P(arr), index, value);
+}
+
+/**
+ * Marks a persistent array as immutable: it is not refcounted anymore, so it
+ * can be shared by every object as a property default and is separated by the
+ * engine on the first write, like the immutable arrays of opcache
+ */
+void zephir_persistent_array_seal(zval *arr)
+{
+	HashTable *ht = Z_ARRVAL_P(arr);
+
+	GC_SET_REFCOUNT(ht, 2);
+	GC_ADD_FLAGS(ht, IS_ARRAY_IMMUTABLE);
+	Z_TYPE_FLAGS_P(arr) = 0;
+}
+
+/**
+ * Assigns a permanent interned string, which can be stored in immutable arrays
+ */
+void zephir_persistent_string(zval *zv, const char *str, size_t length)
+{
+	ZVAL_INTERNED_STR(zv, zend_new_interned_string(zend_string_init(str, length, 1)));
+}
+#endif
@@ -27,6 +27,32 @@
 #include "kernel/globals.h"
 #include "kernel/main.h"
 
+#ifndef HT_IS_PACKED
+#define HT_IS_PACKED(ht) (((ht)->u.flags & HASH_FLAG_PACKED) != 0)
+#endif
+
+/**
+ * Finds an integer key. Packed arrays are indexed directly, without a call
+ * into the engine nor hash probing.
+ */
+static zend_always_inline zval *zephir_hash_index_find(const HashTable *ht, zend_ulong h)
+{
+	zval *zv;
+
+	if (EXPECTED(HT_IS_PACKED(ht))) {
+		if (EXPECTED(h < ht->nNumUsed)) {
+			zv = &ht->arData[h].val;
+			if (EXPECTED(Z_TYPE_P(zv) != IS_UNDEF)) {
+				return zv;
+			}
+		}
+
+		return NULL;
+	}
+
+	return zend_hash_index_find(ht, h);
+}
+
 void ZEPHIR_FASTCALL zephir_create_array(zval *return_value, uint size, int initialize);
 
 /**
@@ -76,6 +102,24 @@ void zephir_fast_array_merge(zval *return_value, zval *array1, zval *array2);
 
 /* In Array */
 int zephir_fast_in_array(zval *needle, zval *haystack);
+int zephir_fast_in_array_strict(zval *needle, zval *haystack);
+int zephir_fast_in_array_indexed(zval *index, zval *needle, zval *haystack, int strict);
+
+/* Immutable arrays built once at module startup */
+#if PHP_VERSION_ID >= 70300
+void zephir_persistent_array_init(zval *arr, uint32_t size);
+void zephir_persistent_array_append(zval *arr, zval *value);
+void zephir_persistent_array_update_string(zval *arr, const char *index, size_t index_length, zval *value);
+void zephir_persistent_array_update_long(zval *arr, zend_long index, zval *value);
+void zephir_persistent_array_seal(zval *arr);
+void zephir_persistent_string(zval *zv, const char *str, size_t length);
+#endif
+
+/** count(), in_array() and array_sum() of range(low, high) with integer bounds, without building it */
+#define ZEPHIR_RANGE_COUNT(low, high) ((low) <= (high) ? (zend_long) (high) - (low) + 1 : (zend_long) (low) - (high) + 1)
+#define ZEPHIR_RANGE_CONTAINS(value, low, high) \
+	((low) <= (high) ? (value) >= (low) && (value) <= (high) : (value) >= (high) && (value) <= (low))
+void zephir_range_sum(zval *return_value, zend_long low, zend_long high);
 
 #define zephir_array_fast_append(arr, value) \
 	do { \
@@ -33,6 +33,8 @@
 #include "kernel/backtrace.h"
 #include "kernel/variables.h"
 
+uint32_t zephir_ic_epoch = 0;
+
 int zephir_has_constructor_ce(const zend_class_entry *ce)
 {
 	while (ce) {
@@ -286,6 +288,65 @@ static void populate_fcic(zend_fcall_info_cache* fcic, zephir_call_type type, ze
 #endif
 }
 
+/**
+ * Initializes the call information shared by every kind of call
+ */
+static void zephir_fcall_info_init(zend_fcall_info *fci, zend_class_entry *obj_ce, zval *object_pp, zval *retval_ptr, uint32_t param_count)
+{
+	fci->size           = sizeof(*fci);
+#if PHP_VERSION_ID < 70100
+	fci->function_table = obj_ce ? &obj_ce->function_table : EG(function_table);
+	fci->symbol_table   = NULL;
+#endif
+	fci->object         = object_pp ? Z_OBJ_P(object_pp) : NULL;
+	fci->retval         = retval_ptr;
+	fci->param_count    = param_count;
+	fci->params         = NULL;
+	fci->no_separation  = 1;
+}
+
+/**
+ * Copies the parameters into the call information and calls the function
+ */
+static int zephir_fcall_invoke(zend_fcall_info *fci, zend_fcall_info_cache *fcic, zval **params)
+{
+	int status;
+	uint32_t i;
+#ifdef _MSC_VER
+	zval *p = emalloc(sizeof(zval) * (fci->param_count + 1));
+#else
+	zval p[fci->param_count];
+#endif
+
+	for (i = 0; i < fci->param_count; ++i) {
+		ZVAL_COPY_VALUE(&p[i], params[i]);
+	}
+
+	fci->params = p;
+	status = zend_call_function(fci, fcic);
+	fci->params = NULL;
+#ifdef _MSC_VER
+	efree(p);
+#endif
+
+	return status;
+}
+
+/**
+ * Releases the return value when the caller does not want it, otherwise
+ * makes it NULL for failed calls and separates returned arrays
+ */
+static void zephir_fcall_retval(zval *retval_ptr, zval *local_retval_ptr, int status)
+{
+	if (!retval_ptr) {
+		zval_ptr_dtor(local_retval_ptr);
+	} else if (FAILURE == status || EG(exception)) {
+		ZVAL_NULL(retval_ptr);
+	} else if (Z_TYPE_P(retval_ptr) == IS_ARRAY) {
+		SEPARATE_ARRAY(retval_ptr);
+	}
+}
+
 /**
  * Calls a function/method in the PHP userland
  */
@@ -328,22 +389,17 @@ int zephir_call_user_function(zval *object_pp, zend_class_entry *obj_ce, zephir_
 
 				temp_cache_entry = zend_hash_find_ptr(zephir_globals_ptr->fcache, zs);
 				if (temp_cache_entry) {
-					cache_entry = &temp_cache_entry;
+					if (cache_entry) {
+						*cache_entry = temp_cache_entry;
+					} else {
+						cache_entry = &temp_cache_entry;
+					}
 				}
 			}
 		}
 	}
 
-	fci.size           = sizeof(fci);
-#if PHP_VERSION_ID < 70100
-	fci.function_table = obj_ce ? &obj_ce->function_table : EG(function_table);
-	fci.symbol_table   = NULL;
-#endif
-	fci.object         = object_pp ? Z_OBJ_P(object_pp) : NULL;
-	fci.retval         = retval_ptr ? retval_ptr : &local_retval_ptr;
-	fci.param_count    = param_count;
-	fci.params         = NULL;
-	fci.no_separation  = 1;
+	zephir_fcall_info_init(&fci, obj_ce, object_pp, retval_ptr ? retval_ptr : &local_retval_ptr, param_count);
 
 #if PHP_VERSION_ID < 70300
 	fcic.initialized = 0;
@@ -371,21 +427,7 @@ int zephir_call_user_function(zval *object_pp, zend_class_entry *obj_ce, zephir_
 	}
 #endif
 
-#ifdef _MSC_VER
-	zval *p = emalloc(sizeof(zval) * (fci.param_count + 1));
-#else
-	zval p[fci.param_count];
-#endif
-	uint32_t i;
-	for (i = 0; i < fci.param_count; ++i) {
-		ZVAL_COPY_VALUE(&p[i], params[i]);
-	}
-
-	fci.params = p;
-	status = zend_call_function(&fci, &fcic);
-#ifdef _MSC_VER
-	efree(p);
-#endif
+	status = zephir_fcall_invoke(&fci, &fcic, params);
 
 	if (Z_TYPE(callable) != IS_UNDEF) {
 		zval_ptr_dtor(&callable);
@@ -416,14 +458,7 @@ int zephir_call_user_function(zval *object_pp, zend_class_entry *obj_ce, zephir_
 		}
 	}
 
-	if (!retval_ptr) {
-		zval_ptr_dtor(&local_retval_ptr);
-	}
-	else if (FAILURE == status || EG(exception)) {
-		ZVAL_NULL(retval_ptr);
-	} else if (Z_TYPE_P(retval_ptr) == IS_ARRAY) {
-		SEPARATE_ARRAY(retval_ptr);
-	}
+	zephir_fcall_retval(retval_ptr, &local_retval_ptr, status);
 
 	return status;
 }
@@ -552,6 +587,99 @@ int zephir_call_class_method_aparams(zval *return_value, zend_class_entry *ce, z
 	return status;
 }
 
+/**
+ * Calls a method on an object using the inline cache of the call site.
+ *
+ * The cache remembers up to ZEPHIR_MAX_IC_ENTRIES pairs of the receiver's
+ * class entry and the method resolved for it. On a hit the method is called
+ * directly, skipping the fcall key, zend_is_callable_ex and populate_fcic.
+ * Misses go through zephir_call_class_method_aparams and fill the cache.
+ */
+int zephir_call_class_method_ic(zval *return_value, zval *object,
+	const char *method_name, uint method_len,
+	zephir_method_ic *ic, uint param_count, zval **params)
+{
+	zend_class_entry *ce;
+	zephir_fcall_cache_entry *func = NULL;
+	zend_fcall_info fci;
+	zend_fcall_info_cache fcic;
+	zval local_retval;
+	uint32_t i;
+	int status;
+
+	if (UNEXPECTED(Z_TYPE_P(object) != IS_OBJECT || !ZEPHIR_GLOBAL(cache_enabled))) {
+		return zephir_call_class_method_aparams(return_value, Z_TYPE_P(object) == IS_OBJECT ? Z_OBJCE_P(object) : NULL, zephir_fcall_method, object, method_name, method_len, NULL, 0, param_count, params);
+	}
+
+	ce = Z_OBJCE_P(object);
+
+	if (UNEXPECTED(ic->epoch != zephir_ic_epoch)) {
+		ic->epoch = zephir_ic_epoch;
+		ic->size  = 0;
+		ic->next  = 0;
+	}
+
+	for (i = 0; i < ic->size; ++i) {
+		if (ic->ce[i] == ce) {
+			func = ic->func[i];
+			break;
+		}
+	}
+
+	if (UNEXPECTED(func == NULL)) {
+		status = zephir_call_class_method_aparams(return_value, ce, zephir_fcall_method, object, method_name, method_len, &func, 0, param_count, params);
+
+		/**
+		 * Only cache methods declared in the function table of the class,
+		 * trampolines (__call) are released after the call
+		 */
+		if (EXPECTED(status != FAILURE) && func) {
+			zend_string *lcname = zend_string_alloc(method_len, 0);
+			zend_str_tolower_copy(ZSTR_VAL(lcname), method_name, method_len);
+
+			if (zend_hash_find_ptr(&ce->function_table, lcname) == func) {
+				i = ic->size < ZEPHIR_MAX_IC_ENTRIES ? ic->size++ : (ic->next++ % ZEPHIR_MAX_IC_ENTRIES);
+				ic->ce[i]   = ce;
+				ic->func[i] = func;
+			}
+
+			zend_string_release(lcname);
+		}
+
+		return status;
+	}
+
+#ifndef ZEPHIR_RELEASE
+	if (return_value != NULL && Z_TYPE_P(return_value) > IS_NULL) {
+		fprintf(stderr, "%s: *return_value must be IS_NULL or IS_UNDEF\n", __func__);
+		zephir_print_backtrace();
+		abort();
+	}
+#endif
+
+	ZVAL_UNDEF(&local_retval);
+
+	zephir_fcall_info_init(&fci, ce, object, return_value ? return_value : &local_retval, param_count);
+	ZVAL_UNDEF(&fci.function_name);
+
+#if PHP_VERSION_ID < 70300
+	fcic.initialized      = 1;
+#endif
+	fcic.function_handler = func;
+	fcic.calling_scope    = ce;
+	fcic.called_scope     = ce;
+	fcic.object           = Z_OBJ_P(object);
+
+	status = zephir_fcall_invoke(&fci, &fcic, params);
+	zephir_fcall_retval(return_value, &local_retval, status);
+
+	if (EG(exception)) {
+		status = FAILURE;
+	}
+
+	return status;
+}
+
 /**
  * Replaces call_user_func_array avoiding function lookup
  * This function does not return FAILURE if an exception has ocurred
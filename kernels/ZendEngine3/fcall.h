@@ -147,6 +147,31 @@ typedef enum _zephir_call_type {
 		ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_aparams(return_value_ptr, Z_TYPE_P(object) == IS_OBJECT ? Z_OBJCE_P(object) : NULL, zephir_fcall_method, object, method, strlen(method), cache, cache_slot, ZEPHIR_CALL_NUM_PARAMS(params_), ZEPHIR_PASS_CALL_PARAMS(params_)); \
 	} while (0)
 
+/*
+ * Method calls using a per call site inline cache. The caches are static
+ * variables of the generated functions, so they are only used in non-ZTS builds.
+ */
+#ifndef ZTS
+#define ZEPHIR_CALL_METHOD_IC(return_value_ptr, object, method, ic, ...) \
+	do { \
+		zval *params_[] = {ZEPHIR_FETCH_VA_ARGS __VA_ARGS__}; \
+		ZEPHIR_OBSERVE_OR_NULLIFY_PPZV(return_value_ptr); \
+		ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_ic(return_value_ptr, object, method, strlen(method), ic, ZEPHIR_CALL_NUM_PARAMS(params_), ZEPHIR_PASS_CALL_PARAMS(params_)); \
+	} while (0)
+
+#define ZEPHIR_RETURN_CALL_METHOD_IC(object, method, ic, ...) \
+	do { \
+		zval *params_[] = {ZEPHIR_FETCH_VA_ARGS __VA_ARGS__}; \
+		ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method_ic(return_value, object, method, strlen(method), ic, ZEPHIR_CALL_NUM_PARAMS(params_), ZEPHIR_PASS_CALL_PARAMS(params_)); \
+	} while (0)
+#else
+#define ZEPHIR_CALL_METHOD_IC(return_value_ptr, object, method, ic, ...) \
+	ZEPHIR_CALL_METHOD(return_value_ptr, object, method, NULL, 0, __VA_ARGS__)
+
+#define ZEPHIR_RETURN_CALL_METHOD_IC(object, method, ic, ...) \
+	ZEPHIR_RETURN_CALL_METHOD(object, method, NULL, 0, __VA_ARGS__)
+#endif
+
 #define ZEPHIR_RETURN_CALL_METHOD_ZVAL(object, method, cache, cache_slot, ...) \
 	do { \
 		char *method_name; \
@@ -302,6 +327,17 @@ int zephir_call_class_method_aparams(zval *return_value_ptr,
 	uint param_count,
 	zval **params) ZEPHIR_ATTR_WARN_UNUSED_RESULT;
 
+int zephir_call_class_method_ic(zval *return_value_ptr,
+	zval *object,
+	const char *method_name,
+	uint method_len,
+	zephir_method_ic *ic,
+	uint param_count,
+	zval **params) ZEPHIR_ATTR_WARN_UNUSED_RESULT;
+
+/** Incremented on each request, invalidates the inline caches filled by previous requests */
+extern uint32_t zephir_ic_epoch;
+
 ZEPHIR_ATTR_WARN_UNUSED_RESULT static inline int zephir_return_call_function(zval *return_value,
 	const char *func, uint func_len, zephir_fcall_cache_entry **cache_entry, int cache_slot, uint param_count, zval **params)
 {
@@ -391,6 +427,37 @@ ZEPHIR_ATTR_WARN_UNUSED_RESULT static inline int zephir_return_call_class_method
 	return SUCCESS;
 }
 
+ZEPHIR_ATTR_WARN_UNUSED_RESULT static inline int zephir_return_call_class_method_ic(zval *return_value,
+	zval *object, const char *method_name, uint method_len,
+	zephir_method_ic *ic, uint param_count, zval **params)
+{
+	zval rv, *rvp = return_value ? return_value : &rv;
+	int status;
+
+	ZVAL_UNDEF(&rv);
+
+	if (return_value) {
+		zval_ptr_dtor(return_value);
+		ZVAL_UNDEF(return_value);
+	}
+
+	status = zephir_call_class_method_ic(rvp, object, method_name, method_len, ic, param_count, params);
+
+	if (status == FAILURE) {
+		if (return_value && EG(exception)) {
+			ZVAL_NULL(return_value);
+		}
+
+		return FAILURE;
+	}
+
+	if (!return_value) {
+		zval_ptr_dtor(&rv);
+	}
+
+	return SUCCESS;
+}
+
 /** Fast call_user_func_array/call_user_func */
 int zephir_call_user_func_array_noex(zval *return_value, zval *handler, zval *params) ZEPHIR_ATTR_WARN_UNUSED_RESULT;
 
@@ -32,6 +32,7 @@
 
 #include "kernel/main.h"
 #include "kernel/memory.h"
+#include "kernel/simd.h"
 
 #include <Zend/zend_exceptions.h>
 #include <Zend/zend_interfaces.h>
@@ -42,9 +43,10 @@
  */
 void zephir_filter_alphanum(zval *return_value, zval *param) {
 
-	unsigned int i;
+	size_t i, length, span, n = 0;
 	unsigned char ch;
-	smart_str filtered_str = {0};
+	zend_string *filtered;
+	char *src, *dst;
 	zval copy;
 	int use_copy = 0;
 
@@ -55,13 +57,30 @@ void zephir_filter_alphanum(zval *return_value, zval *param) {
 		}
 	}
 
-	for (i = 0; i < Z_STRLEN_P(param); i++) {
-		ch = Z_STRVAL_P(param)[i];
+	src = Z_STRVAL_P(param);
+	length = Z_STRLEN_P(param);
+
+	filtered = zend_string_alloc(length, 0);
+	dst = ZSTR_VAL(filtered);
+
+	for (i = 0; i < length; i++) {
+		/* Copy the run of ASCII alphanumeric bytes at once */
+		span = zephir_simd_span_alnum(src + i, length - i);
+		memcpy(dst + n, src + i, span);
+		n += span;
+		i += span;
+
+		if (i == length) {
+			break;
+		}
+
+		ch = src[i];
 		if (ch == '\0') {
 			break;
 		}
+		/* Other bytes may still be alphanumeric in the current locale */
 		if (isalnum(ch)) {
-			smart_str_appendc(&filtered_str, ch);
+			dst[n++] = ch;
 		}
 	}
 
@@ -69,13 +88,15 @@ void zephir_filter_alphanum(zval *return_value, zval *param) {
 		zval_dtor(param);
 	}
 
-	smart_str_0(&filtered_str);
-
-	if (filtered_str.s) {
-		RETURN_STR(filtered_str.s);
-	} else {
+	if (n == 0) {
+		zend_string_free(filtered);
 		RETURN_EMPTY_STRING();
 	}
+
+	filtered = zend_string_truncate(filtered, n, 0);
+	ZSTR_VAL(filtered)[n] = '\0';
+
+	RETURN_NEW_STR(filtered);
 }
 
 /**
@@ -109,54 +130,116 @@ void zephir_is_basic_charset(zval *return_value, const zval *param)
 	RETURN_STRING("ISO-8859-1");
 }
 
-static long zephir_unpack(char *data, int size, int issigned, int *map)
+#define ZEPHIR_ESCAPE_ALNUM     1
+#define ZEPHIR_ESCAPE_WHITELIST 2
+
+/**
+ * Classes of the characters below 256: ASCII alphanumeric characters are never
+ * escaped, the ones in the whitelist are not escaped by escape_js
+ */
+static const unsigned char zephir_escape_classes[256] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	2, 2, 0, 2, 2, 0, 0, 0, 2, 2, 2, 2, 2, 2, 2, 2,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 0, 0, 0, 2,
+	0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2,
+	0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+/**
+ * Writes the escape sequence of a code point: the escape prefix, the code
+ * point in lowercase hexadecimal without leading zeros and the extra suffix
+ */
+static zend_always_inline char *zephir_escape_codepoint(char *out, uint32_t value, const char *escape_char, size_t escape_length, char escape_extra)
 {
-	long result;
-	char *cresult = (char *) &result;
-	int i;
+	static const char digits[] = "0123456789abcdef";
+	int shift = 28;
+
+	memcpy(out, escape_char, escape_length);
+	out += escape_length;
 
-	result = issigned ? -1 : 0;
+	while (shift > 0 && !(value >> shift)) {
+		shift -= 4;
+	}
+	for (; shift >= 0; shift -= 4) {
+		*out++ = digits[(value >> shift) & 0x0F];
+	}
 
-	for (i = 0; i < size; i++) {
-		cresult[map[i]] = *data++;
+	if (escape_extra != '\0') {
+		*out++ = escape_extra;
 	}
 
-	return result;
+	return out;
 }
 
 /**
- * Converts an unsigned long to a char*
+ * Decodes an UTF-8 sequence, returning its length or 0 when it is invalid
  */
-static inline char *zephir_longtohex(unsigned long value) {
+static size_t zephir_utf8_decode(const unsigned char *str, size_t length, uint32_t *value)
+{
+	unsigned char c = str[0];
+
+	if (c < 0xC2) {
+		return 0;
+	}
+
+	if (c < 0xE0) {
+		if (length < 2 || (str[1] & 0xC0) != 0x80) {
+			return 0;
+		}
+		*value = ((uint32_t) (c & 0x1F) << 6) | (str[1] & 0x3F);
+		return 2;
+	}
 
-	static char digits[] = "0123456789abcdef";
-	char buf[(sizeof(unsigned long) << 3) + 1];
-	char *ptr, *end;
+	if (c < 0xF0) {
+		if (length < 3 || (str[1] & 0xC0) != 0x80 || (str[2] & 0xC0) != 0x80) {
+			return 0;
+		}
+		*value = ((uint32_t) (c & 0x0F) << 12) | ((uint32_t) (str[1] & 0x3F) << 6) | (str[2] & 0x3F);
+		if (*value < 0x800 || (*value >= 0xD800 && *value <= 0xDFFF)) {
+			return 0;
+		}
+		return 3;
+	}
 
-	end = ptr = buf + sizeof(buf) - 1;
-	*ptr = '\0';
-	do {
-		*--ptr = digits[value & 0x0F];
-		value >>= 4;
-	} while (ptr > buf && value);
+	if (c < 0xF5) {
+		if (length < 4 || (str[1] & 0xC0) != 0x80 || (str[2] & 0xC0) != 0x80 || (str[3] & 0xC0) != 0x80) {
+			return 0;
+		}
+		*value = ((uint32_t) (c & 0x07) << 18) | ((uint32_t) (str[1] & 0x3F) << 12) | ((uint32_t) (str[2] & 0x3F) << 6) | (str[3] & 0x3F);
+		if (*value < 0x10000 || *value > 0x10FFFF) {
+			return 0;
+		}
+		return 4;
+	}
 
-	return estrndup(ptr, end - ptr);
+	return 0;
 }
 
 /**
- * Perform escaping of non-alphanumeric characters to different formats
+ * Perform escaping of non-alphanumeric characters to different formats.
+ * The input must be UTF-32 (big endian).
  */
 void zephir_escape_multi(zval *return_value, zval *param, const char *escape_char, unsigned int escape_length, char escape_extra, int use_whitelist)
 {
-
-	unsigned int i;
 	zval copy;
-	smart_str escaped_str = {0};
-	char machine_little_endian, *hex;
-	int big_endian_long_map[4];
-	int use_copy = 0, machine_endian_check = 1;
-	int issigned = 0;
-	long value;
+	zend_string *escaped;
+	const unsigned char *src, *end;
+	unsigned char mask = ZEPHIR_ESCAPE_ALNUM | (use_whitelist ? ZEPHIR_ESCAPE_WHITELIST : 0);
+	uint32_t value;
+	size_t length;
+	char *out;
+	int use_copy = 0;
 
 	if (Z_TYPE_P(param) != IS_STRING) {
 		use_copy = zend_make_printable_zval(param, &copy);
@@ -165,126 +248,132 @@ void zephir_escape_multi(zval *return_value, zval *param, const char *escape_cha
 		}
 	}
 
-	if (Z_STRLEN_P(param) <= 0) {
-		RETURN_FALSE;
-	}
-
-	/**
-	 * This is how the big_ending_long_map is calculated as in 'pack'
-	 */
-	machine_little_endian = ((char *) &machine_endian_check)[0];
-	if (machine_little_endian) {
-		big_endian_long_map[0] = 3;
-		big_endian_long_map[1] = 2;
-		big_endian_long_map[2] = 1;
-		big_endian_long_map[3] = 0;
-	} else {
-		int size = sizeof(Z_LVAL_P(param));
-		big_endian_long_map[0] = size - 4;
-		big_endian_long_map[1] = size - 3;
-		big_endian_long_map[2] = size - 2;
-		big_endian_long_map[3] = size - 1;
-	}
+	length = Z_STRLEN_P(param);
 
 	/**
 	 * The input must be a valid UTF-32 string
 	 */
-	if ((Z_STRLEN_P(param) % 4) != 0) {
-		RETURN_FALSE;
+	if (length == 0 || (length % 4) != 0) {
+		RETVAL_FALSE;
+		goto done;
 	}
 
-	for (i = 0; i < Z_STRLEN_P(param); i += 4) {
-
-		issigned = Z_STRVAL_P(param)[i] & 0x80;
+	/* Every character produces at most the escape, 8 digits and the extra character */
+	escaped = zend_string_safe_alloc(length / 4, escape_length + 9, 0, 0);
+	out = ZSTR_VAL(escaped);
 
-		value = 0;
-		if (sizeof(long) > 4 && issigned) {
-			value = ~INT_MAX;
-		}
-
-		value |= zephir_unpack(&Z_STRVAL_P(param)[i], 4, issigned, big_endian_long_map);
-		if (sizeof(long) > 4) {
-			value = (unsigned int) value;
-		}
+	src = (const unsigned char *) Z_STRVAL_P(param);
+	end = src + length;
+	for (; src < end; src += 4) {
+		value = ((uint32_t) src[0] << 24) | ((uint32_t) src[1] << 16) | ((uint32_t) src[2] << 8) | src[3];
 
 		/**
 		 * CSS 2.1 section 4.1.3: "It is undefined in CSS 2.1 what happens if a
 		 * style sheet does contain a character with Unicode codepoint zero."
 		 */
-		if (value == '\0') {
-			RETURN_FALSE;
+		if (value == 0) {
+			zend_string_free(escaped);
+			RETVAL_FALSE;
+			goto done;
 		}
 
-		/**
-		 * Alphanumeric characters are not escaped
-		 */
-		if (value < 256 && isalnum(value)) {
-			smart_str_appendc(&escaped_str, (unsigned char) value);
+		if (value < 256 && (zephir_escape_classes[value] & mask)) {
+			*out++ = (char) value;
 			continue;
 		}
 
-		/**
-		 * Chararters in the whitelist are left as they are
-		 */
-		if (use_whitelist) {
-			switch (value) {
-				case ' ':
-				case '/':
-				case '*':
-				case '+':
-				case '-':
-				case '\t':
-				case '\n':
-				case '^':
-				case '$':
-				case '!':
-				case '?':
-				case '\\':
-				case '#':
-				case '}':
-				case '{':
-				case ')':
-				case '(':
-				case ']':
-				case '[':
-				case '.':
-				case ',':
-				case ':':
-				case ';':
-				case '_':
-				case '|':
-					smart_str_appendc(&escaped_str, (unsigned char) value);
-					continue;
-			}
-		}
+		out = zephir_escape_codepoint(out, value, escape_char, escape_length, escape_extra);
+	}
 
-		/**
-		 * Convert character to hexadecimal
-		 */
-		hex = zephir_longtohex(value);
+	length = out - ZSTR_VAL(escaped);
+	escaped = zend_string_truncate(escaped, length, 0);
+	ZSTR_VAL(escaped)[length] = '\0';
+	RETVAL_NEW_STR(escaped);
 
-		/**
-		 * Append the escaped character
-		 */
-		smart_str_appendl(&escaped_str, escape_char, escape_length);
-		smart_str_appendl(&escaped_str, hex, strlen(hex));
-		if (escape_extra != '\0') {
-			smart_str_appendc(&escaped_str, escape_extra);
+done:
+	if (use_copy) {
+		zval_dtor(param);
+	}
+}
+
+/**
+ * Perform escaping of non-alphanumeric characters to different formats.
+ * The input must be UTF-8, invalid sequences return false.
+ */
+void zephir_escape_multi_utf8(zval *return_value, zval *param, const char *escape_char, unsigned int escape_length, char escape_extra, int use_whitelist)
+{
+	zval copy;
+	zend_string *escaped;
+	const unsigned char *src, *end, *run;
+	unsigned char mask = ZEPHIR_ESCAPE_ALNUM | (use_whitelist ? ZEPHIR_ESCAPE_WHITELIST : 0);
+	uint32_t value;
+	size_t length, sequence;
+	char *out;
+	int use_copy = 0;
+
+	if (Z_TYPE_P(param) != IS_STRING) {
+		use_copy = zend_make_printable_zval(param, &copy);
+		if (use_copy) {
+			param = &copy;
 		}
+	}
 
-		efree(hex);
+	length = Z_STRLEN_P(param);
+	if (length == 0) {
+		RETVAL_FALSE;
+		goto done;
 	}
 
-	if (use_copy) {
-		zval_dtor(param);
+	/* ASCII characters produce the longest escapes per input byte: the escape, 2 digits and the extra character */
+	escaped = zend_string_safe_alloc(length, escape_length + 3, 0, 0);
+	out = ZSTR_VAL(escaped);
+
+	src = (const unsigned char *) Z_STRVAL_P(param);
+	end = src + length;
+	while (src < end) {
+		if (*src < 0x80) {
+			if (zephir_escape_classes[*src] & mask) {
+				/* Copy the whole run of characters left as they are */
+				run = src;
+				do {
+					src++;
+				} while (src < end && (zephir_escape_classes[*src] & mask));
+
+				memcpy(out, run, src - run);
+				out += src - run;
+				continue;
+			}
+
+			if (*src == '\0') {
+				zend_string_free(escaped);
+				RETVAL_FALSE;
+				goto done;
+			}
+
+			out = zephir_escape_codepoint(out, *src, escape_char, escape_length, escape_extra);
+			src++;
+			continue;
+		}
+
+		sequence = zephir_utf8_decode(src, end - src, &value);
+		if (!sequence) {
+			zend_string_free(escaped);
+			RETVAL_FALSE;
+			goto done;
+		}
+
+		out = zephir_escape_codepoint(out, value, escape_char, escape_length, escape_extra);
+		src += sequence;
 	}
 
-	smart_str_0(&escaped_str);
+	length = out - ZSTR_VAL(escaped);
+	escaped = zend_string_truncate(escaped, length, 0);
+	ZSTR_VAL(escaped)[length] = '\0';
+	RETVAL_NEW_STR(escaped);
 
-	if (escaped_str.s) {
-		RETURN_STR(escaped_str.s);
-	} else {
-		RETURN_EMPTY_STRING();
+done:
+	if (use_copy) {
+		zval_dtor(param);
 	}
 }
 
@@ -303,3 +392,19 @@ void zephir_escape_js(zval *return_value, zval *param)
 {
 	zephir_escape_multi(return_value, param, "\\x", sizeof("\\x")-1, '\0', 1);
 }
+
+/**
+ * Escapes non-alphanumeric characters of an UTF-8 string to \HH+space
+ */
+void zephir_escape_css_utf8(zval *return_value, zval *param)
+{
+	zephir_escape_multi_utf8(return_value, param, "\\", sizeof("\\")-1, ' ', 0);
+}
+
+/**
+ * Escapes non-alphanumeric characters of an UTF-8 string to \xHH+
+ */
+void zephir_escape_js_utf8(zval *return_value, zval *param)
+{
+	zephir_escape_multi_utf8(return_value, param, "\\x", sizeof("\\x")-1, '\0', 1);
+}
@@ -32,6 +32,33 @@ typedef struct _zephir_function_cache {
 
 typedef zend_function zephir_fcall_cache_entry;
 
+#define ZEPHIR_MAX_IC_ENTRIES 4
+
+/** Per call site method cache, maps the class of the receiver to the called method */
+typedef struct _zephir_method_ic {
+	uint32_t epoch;
+	uint32_t size;
+	uint32_t next;
+	zend_class_entry *ce[ZEPHIR_MAX_IC_ENTRIES];
+	zephir_fcall_cache_entry *func[ZEPHIR_MAX_IC_ENTRIES];
+} zephir_method_ic;
+
+/** Per call site cache of create_instance(), maps a class name to its class entry and constructor */
+typedef struct _zephir_instance_ic {
+	uint32_t epoch;
+	zend_bool std_constructor;
+	zend_string *name;
+	zend_class_entry *ce;
+	zend_function *constructor;
+} zephir_instance_ic;
+
+/** Request-scoped stack of method memory frames (see kernel/memory.c) */
+typedef struct _zephir_frame_arena {
+	struct _zephir_memory_frame_chunk *first;
+	struct _zephir_memory_frame_chunk *current;
+	size_t top;
+} zephir_frame_arena;
+
 #define ZEPHIR_INIT_FUNCS(class_functions) static const zend_function_entry class_functions[] =
 
 /** Define FASTCALL */
@@ -67,6 +94,7 @@ typedef zend_function zephir_fcall_cache_entry;
 # define ZEPHIR_ATTR_PURE __attribute__((pure))
 # define ZEPHIR_ATTR_CONST __attribute__((const))
 # define ZEPHIR_ATTR_WARN_UNUSED_RESULT __attribute__((warn_unused_result))
+# define ZEPHIR_ATTR_UNUSED __attribute__((unused))
 #else
 # define ZEPHIR_ATTR_NONNULL
 # define ZEPHIR_ATTR_NONNULL1(x)
@@ -75,6 +103,7 @@ typedef zend_function zephir_fcall_cache_entry;
 # define ZEPHIR_ATTR_PURE
 # define ZEPHIR_ATTR_CONST
 # define ZEPHIR_ATTR_WARN_UNUSED_RESULT
+# define ZEPHIR_ATTR_UNUSED
 #endif
 
 #if !defined(__GNUC__) && !(defined(__SUNPRO_C) && (__SUNPRO_C >= 0x590))
@@ -25,6 +25,7 @@
 #include "kernel/fcall.h"
 #include "kernel/object.h"
 #include "kernel/exception.h"
+#include "kernel/simd.h"
 
 
 zend_string* i_parent = NULL;
@@ -585,4 +586,6 @@ void zephir_module_init()
 	i_parent = zend_new_interned_string(zend_string_init(ZEND_STRL("parent"), 1));
 	i_static = zend_new_interned_string(zend_string_init(ZEND_STRL("static"), 1));
 	i_self   = zend_new_interned_string(zend_string_init(ZEND_STRL("self"), 1));
+
+	zephir_simd_init();
 }
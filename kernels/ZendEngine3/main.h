@@ -271,6 +271,27 @@ int zephir_fetch_parameters(int num_args, int required_args, int optional_args,
 		RETURN_NULL(); \
 	}
 
+/** Inline parameter fetching, the compiler emits the checks for the arity of each method */
+#define ZEPHIR_CHECK_PARAMS_NUM(wrong_num) \
+	if (UNEXPECTED(wrong_num)) { \
+		zephir_throw_exception_string(spl_ce_BadMethodCallException, SL("Wrong number of parameters")); \
+		RETURN_MM_NULL(); \
+	}
+
+#define ZEPHIR_CHECK_PARAMS_NUM_WITHOUT_MEMORY_GROW(wrong_num) \
+	if (UNEXPECTED(wrong_num)) { \
+		zephir_throw_exception_string(spl_ce_BadMethodCallException, SL("Wrong number of parameters")); \
+		RETURN_NULL(); \
+	}
+
+#define ZEPHIR_FETCH_PARAM(param, num) \
+	param = ZEND_CALL_ARG(execute_data, num)
+
+#define ZEPHIR_FETCH_OPTIONAL_PARAM(param, num) \
+	if (ZEND_NUM_ARGS() >= num) { \
+		param = ZEND_CALL_ARG(execute_data, num); \
+	}
+
 #define ZEPHIR_CREATE_OBJECT(obj, class_type) \
 	{ \
 		zend_object *object = zend_objects_new(class_type); \
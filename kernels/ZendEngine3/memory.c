@@ -38,9 +38,12 @@
  * This adds a minimum overhead to execution but save us the work of
  * free memory in each method manually.
  *
- * The whole memory frame is an open double-linked list which start is an
- * allocated empty frame that points to the real first frame. The start
- * memory frame is globally accessed using ZEPHIR_GLOBAL(start_frame)
+ * Frames are pushed to and popped from a request-scoped arena owned by the
+ * extension globals (ZEPHIR_GLOBAL(frame_arena)). The arena is a list of
+ * chunks holding ZEPHIR_NUM_PREALLOCATED_FRAMES frames each, every frame
+ * carries ZEPHIR_NUM_PREALLOCATED_SLOTS inline observer slots. Chunks are
+ * reused across calls and released in RSHUTDOWN, so growing and restoring
+ * a frame does not touch the heap in the common case.
  *
  * Not all methods must grow/restore the zephir_memory_entry.
  */
@@ -54,36 +57,81 @@ static zend_always_inline zend_execute_data* find_symbol_table(zend_execute_data
     return ex;
 }
 
+static zend_always_inline zephir_memory_frame* zephir_memory_push_frame(const char *func)
+{
+	zephir_frame_arena *arena = &ZEPHIR_GLOBAL(frame_arena);
+	zephir_memory_frame_chunk *chunk = arena->current;
+	zephir_memory_frame *frame;
+
+	if (UNEXPECTED(chunk == NULL || arena->top == ZEPHIR_NUM_PREALLOCATED_FRAMES)) {
+		zephir_memory_frame_chunk *next = chunk ? chunk->next : arena->first;
+
+		if (next == NULL) {
+			next = (zephir_memory_frame_chunk *) emalloc(sizeof(zephir_memory_frame_chunk));
+			next->prev = chunk;
+			next->next = NULL;
+			if (chunk) {
+				chunk->next = next;
+			} else {
+				arena->first = next;
+			}
+		}
+
+		arena->current = chunk = next;
+		arena->top     = 0;
+	}
+
+	frame = &chunk->frames[arena->top++];
+
+	frame->chunk                       = chunk;
+	frame->entry.pointer               = 0;
+	frame->globals.active_memory       = &frame->entry;
+	frame->globals.active_symbol_table = NULL;
+
+#ifndef ZEPHIR_RELEASE
+	frame->entry.permanent = 0;
+	frame->entry.func      = func;
+#endif
+
+	return frame;
+}
+
 /**
  * Adds a memory frame in the current executed method
  */
-void ZEPHIR_FASTCALL zephir_memory_grow_stack(zephir_method_globals *g, const char *func)
+zephir_method_globals* ZEPHIR_FASTCALL zephir_memory_grow_stack(const char *func)
 {
-	zephir_memory_entry *entry;
-	if (g->active_memory == NULL) {
-		zephir_memory_entry *active_memory;
-		size_t i;
+	zephir_memory_frame *frame = zephir_memory_push_frame(func);
 
-		active_memory = (zephir_memory_entry *) pecalloc(1, sizeof(zephir_memory_entry), 0);
+	frame->observers       = frame->slots;
+	frame->entry.addresses = frame->slots;
+	frame->entry.capacity  = ZEPHIR_NUM_PREALLOCATED_SLOTS;
 
-		active_memory->addresses       = pecalloc(24, sizeof(zval*), 0);
-		active_memory->capacity        = 24;
+	return &frame->globals;
+}
 
-		g->active_memory = active_memory;
-	}
+/**
+ * Adds a memory frame which observes variables into a table provided by the
+ * method. The compiler sizes the table to the number of zvals the method may
+ * observe, so it never has to grow.
+ */
+zephir_method_globals* ZEPHIR_FASTCALL zephir_memory_grow_stack_slots(zval **slots, size_t capacity, const char *func)
+{
+	zephir_memory_frame *frame = zephir_memory_push_frame(func);
 
-	assert(g->active_memory != NULL);
-	assert(g->active_memory->pointer == 0);
+	frame->observers       = slots;
+	frame->entry.addresses = slots;
+	frame->entry.capacity  = capacity;
 
-#ifndef ZEPHIR_RELEASE
-	g->active_memory->func = func;
-#endif
+	return &frame->globals;
 }
 
 void ZEPHIR_FASTCALL zephir_memory_restore_stack(zephir_method_globals *g, const char *func)
 {
 	size_t i;
-	zephir_memory_entry *prev, *active_memory;
+	zephir_memory_entry *active_memory;
+	zephir_memory_frame *frame;
+	zephir_frame_arena *arena;
 	zephir_symbol_table *active_symbol_table;
 	zval *ptr;
 #ifndef ZEPHIR_RELEASE
@@ -179,13 +227,18 @@ void ZEPHIR_FASTCALL zephir_memory_restore_stack(zephir_method_globals *g, const
 	active_memory->func = NULL;
 #endif
 
-	if (active_memory->addresses != NULL) {
-		pefree(active_memory->addresses, 0);
+	frame = (zephir_memory_frame *) g;
+	if (UNEXPECTED(active_memory->addresses != frame->observers)) {
+		efree(active_memory->addresses);
 	}
 
-	pefree(g->active_memory, 0);
 	g->active_memory = NULL;
 
+	/* Pop the frame (and any frame left above it by a bailout) off the arena */
+	arena          = &ZEPHIR_GLOBAL(frame_arena);
+	arena->current = frame->chunk;
+	arena->top     = (size_t) (frame - frame->chunk->frames);
+
 #ifndef ZEPHIR_RELEASE
 	if (show_backtrace == 1) {
 		zephir_print_backtrace();
@@ -201,6 +254,11 @@ void zephir_initialize_memory(zend_zephir_globals_def *zephir_globals_ptr)
 	zephir_globals_ptr->fcache = pemalloc(sizeof(HashTable), 1);
 	zend_hash_init(zephir_globals_ptr->fcache, 128, NULL, NULL, 1); // zephir_fcall_cache_dtor
 
+	memset(&zephir_globals_ptr->frame_arena, 0, sizeof(zephir_frame_arena));
+
+	/* Inline caches filled by a previous request may refer to freed classes */
+	++zephir_ic_epoch;
+
 	zephir_globals_ptr->initialized = 1;
 }
 
@@ -211,12 +269,21 @@ void zephir_deinitialize_memory()
 {
 	size_t i;
 	zend_zephir_globals_def *zephir_globals_ptr = ZEPHIR_VGLOBAL;
+	zephir_memory_frame_chunk *chunk, *next;
 
 	if (zephir_globals_ptr->initialized != 1) {
 		zephir_globals_ptr->initialized = 0;
 		return;
 	}
 
+	chunk = zephir_globals_ptr->frame_arena.first;
+	while (chunk) {
+		next = chunk->next;
+		efree(chunk);
+		chunk = next;
+	}
+	memset(&zephir_globals_ptr->frame_arena, 0, sizeof(zephir_frame_arena));
+
 	zend_hash_destroy(zephir_globals_ptr->fcache);
 	pefree(zephir_globals_ptr->fcache, 1);
 	zephir_globals_ptr->fcache = NULL;
@@ -352,7 +419,16 @@ void ZEPHIR_FASTCALL zephir_do_memory_observe(zval *var, const zephir_method_glo
 #endif
 
 	if (UNEXPECTED(frame->pointer == frame->capacity)) {
-		void *buf = perealloc(frame->addresses, sizeof(zval *) * (frame->capacity + 16), 0);
+		void *buf;
+
+		/* The initial table belongs to the arena or the method, move it to the heap on the first overflow */
+		if (frame->addresses == ((const zephir_memory_frame *) g)->observers) {
+			buf = emalloc(sizeof(zval *) * (frame->capacity + 16));
+			memcpy(buf, frame->addresses, sizeof(zval *) * frame->capacity);
+		} else {
+			buf = erealloc(frame->addresses, sizeof(zval *) * (frame->capacity + 16));
+		}
+
 		if (EXPECTED(buf != NULL)) {
 			frame->capacity += 16;
 			frame->addresses = buf;
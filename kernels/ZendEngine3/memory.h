@@ -31,6 +31,7 @@
 #endif
 
 #define ZEPHIR_NUM_PREALLOCATED_FRAMES 25
+#define ZEPHIR_NUM_PREALLOCATED_SLOTS 24
 
 /** Memory frame */
 typedef struct _zephir_memory_entry {
@@ -58,17 +59,42 @@ typedef struct _zephir_method_globals {
 	zephir_symbol_table *active_symbol_table;
 } zephir_method_globals;
 
+/** A memory frame as it is stored in the frame arena */
+typedef struct _zephir_memory_frame {
+	zephir_method_globals globals;
+	zephir_memory_entry entry;
+	struct _zephir_memory_frame_chunk *chunk;
+	zval **observers; /**< Either slots or the observer table of the method */
+	zval *slots[ZEPHIR_NUM_PREALLOCATED_SLOTS];
+} zephir_memory_frame;
+
+/** Block of preallocated frames, chunks are kept until the end of the request */
+typedef struct _zephir_memory_frame_chunk {
+	struct _zephir_memory_frame_chunk *prev;
+	struct _zephir_memory_frame_chunk *next;
+	zephir_memory_frame frames[ZEPHIR_NUM_PREALLOCATED_FRAMES];
+} zephir_memory_frame_chunk;
+
 /* Memory Frames */
-void ZEPHIR_FASTCALL zephir_memory_grow_stack(zephir_method_globals *g, const char *func);
+zephir_method_globals* ZEPHIR_FASTCALL zephir_memory_grow_stack(const char *func);
+zephir_method_globals* ZEPHIR_FASTCALL zephir_memory_grow_stack_slots(zval **slots, size_t capacity, const char *func);
 void ZEPHIR_FASTCALL zephir_memory_restore_stack(zephir_method_globals *g, const char *func);
 
 #define ZEPHIR_MM_GROW()  \
-	ZEPHIR_METHOD_GLOBALS_PTR = pecalloc(1, sizeof(zephir_method_globals), 0); \
-	zephir_memory_grow_stack(ZEPHIR_METHOD_GLOBALS_PTR, __func__);
+	ZEPHIR_METHOD_GLOBALS_PTR = zephir_memory_grow_stack(__func__);
+
+/* Grows the stack using a compile-time sized observer table declared by the method */
+#ifdef ZEPHIR_RELEASE
+#define ZEPHIR_MM_GROW_SLOTS(slots)  \
+	ZEPHIR_METHOD_GLOBALS_PTR = zephir_memory_grow_stack_slots(slots, sizeof(slots) / sizeof(zval *), __func__);
+#else
+#define ZEPHIR_MM_GROW_SLOTS(slots)  \
+	(void) slots; \
+	ZEPHIR_MM_GROW();
+#endif
 
 #define ZEPHIR_MM_RESTORE() \
 	zephir_memory_restore_stack(ZEPHIR_METHOD_GLOBALS_PTR, __func__); \
-	pefree(ZEPHIR_METHOD_GLOBALS_PTR, 0); \
 	ZEPHIR_METHOD_GLOBALS_PTR = NULL;
 
 void zephir_initialize_memory(zend_zephir_globals_def *zephir_globals_ptr);
@@ -972,9 +972,8 @@ int zephir_read_static_property_ce(zval *result, zend_class_entry *ce, const cha
 /*
  * Multiple array-offset update
  */
-int zephir_update_static_property_array_multi_ce(zend_class_entry *ce, const char *property, zend_uint property_length, zval *value, const char *types, int types_length, int types_count, ...)
+static int zephir_update_static_property_array_multi_ce_ex(zend_class_entry *ce, const char *property, zend_uint property_length, zval *value, const char *types, int types_length, int types_count, va_list ap)
 {
-	va_list ap;
 	zval tmp_arr;
 	int separated = 0;
 
@@ -1019,10 +1018,8 @@ int zephir_update_static_property_array_multi_ce(zend_class_entry *ce, const cha
 		}
 	}
 
-	va_start(ap, types_count);
 	SEPARATE_ZVAL_IF_NOT_REF(&tmp_arr);
 	zephir_array_update_multi_ex(&tmp_arr, value, types, types_length, types_count, ap);
-	va_end(ap);
 
 	if (separated) {
 		zend_update_static_property(ce, property, property_length, &tmp_arr);
@@ -1039,6 +1036,45 @@ int zephir_update_static_property_array_multi_ce(zend_class_entry *ce, const cha
 	return SUCCESS;
 }
 
+int zephir_update_static_property_array_multi_ce(zend_class_entry *ce, const char *property, zend_uint property_length, zval *value, const char *types, int types_length, int types_count, ...)
+{
+	va_list ap;
+	int result;
+
+	va_start(ap, types_count);
+	result = zephir_update_static_property_array_multi_ce_ex(ce, property, property_length, value, types, types_length, types_count, ap);
+	va_end(ap);
+
+	return result;
+}
+
+/**
+ * Multiple array-offset update through the slot of the static property, see
+ * zephir_fetch_static_property_slot(). The array is updated in place when it
+ * is not shared, without reading and writing back the property by name
+ */
+int zephir_update_static_property_array_multi_slot_ex(zend_class_entry *ce, zend_property_info **info, const char *property, zend_uint property_length, zval *value, const char *types, int types_length, int types_count, ...)
+{
+	va_list ap;
+	int result = SUCCESS;
+	zval *slot = zephir_fetch_static_property_slot(ce, info, property, property_length);
+
+	va_start(ap, types_count);
+	if (EXPECTED(slot != NULL && (Z_TYPE_P(slot) == IS_ARRAY || Z_TYPE_P(slot) == IS_NULL))) {
+		if (Z_TYPE_P(slot) == IS_NULL) {
+			array_init(slot);
+		} else {
+			SEPARATE_ARRAY(slot);
+		}
+		zephir_array_update_multi_ex(slot, value, types, types_length, types_count, ap);
+	} else {
+		result = zephir_update_static_property_array_multi_ce_ex(ce, property, property_length, value, types, types_length, types_count, ap);
+	}
+	va_end(ap);
+
+	return result;
+}
+
 /**
  * Increments an object property
  */
@@ -1131,127 +1167,203 @@ int zephir_create_closure_ex(zval *return_value, zval *this_ptr, zend_class_entr
 	return SUCCESS;
 }
 
+/** Constructors receiving at most this number of arguments get them from the stack */
+#define ZEPHIR_INSTANCE_MAX_ARGS 16
+
 /**
- * Creates a new instance dynamically. Call constructor without parameters
+ * Fetches the class to instantiate, through the cache of the call site if any.
+ *
+ * Interned names hit by pointer, other names are compared with the name of the
+ * cached class. self, parent and static depend on the calling scope and are
+ * never cached.
  */
-int zephir_create_instance(zval *return_value, const zval *class_name)
+static zend_class_entry *zephir_fetch_instance_class(zend_string *class_name, int fetch_type, zephir_instance_ic *ic)
 {
 	zend_class_entry *ce;
 
-	if (Z_TYPE_P(class_name) != IS_STRING) {
-		zephir_throw_exception_string(spl_ce_RuntimeException, SL("Invalid class name"));
-		return FAILURE;
+	if (ic) {
+		if (UNEXPECTED(ic->epoch != zephir_ic_epoch)) {
+			ic->epoch = zephir_ic_epoch;
+			ic->name  = NULL;
+			ic->ce    = NULL;
+		}
+
+		if (EXPECTED(ic->ce != NULL) && (ic->name == class_name || zend_string_equals_ci(ic->ce->name, class_name))) {
+			return ic->ce;
+		}
 	}
 
-	ce = zend_fetch_class(Z_STR_P(class_name), ZEND_FETCH_CLASS_DEFAULT);
-	if (!ce) {
-		ZVAL_NULL(return_value);
-		return FAILURE;
+	ce = zend_fetch_class(class_name, fetch_type);
+	if (ic && ce && zend_get_class_fetch_type(class_name) == ZEND_FETCH_CLASS_DEFAULT) {
+		ic->name = ZSTR_IS_INTERNED(class_name) ? class_name : NULL;
+		ic->ce   = ce;
+		ic->std_constructor = 0;
 	}
 
-	if(UNEXPECTED(object_init_ex(return_value, ce) != SUCCESS)) {
-    	return FAILURE;
-    }
+	return ce;
+}
 
-	if (EXPECTED(Z_OBJ_HT_P(return_value)->get_constructor)) {
-		zend_object* obj    = Z_OBJ_P(return_value);
-		zend_function* ctor = Z_OBJ_HT_P(return_value)->get_constructor(obj);
-		if (ctor) {
-			zend_fcall_info fci;
-			zend_fcall_info_cache fcc;
+/**
+ * Returns the constructor of a new object. Public constructors of objects
+ * using the standard handler are remembered by the cache of the call site,
+ * skipping get_constructor on the next instantiations.
+ */
+static zend_function *zephir_fetch_instance_constructor(zend_object *obj, zephir_instance_ic *ic)
+{
+	zend_function *ctor;
 
-			zend_class_entry* ce = Z_OBJCE_P(return_value);
+	if (!obj->handlers->get_constructor) {
+		return NULL;
+	}
 
-			fci.size             = sizeof(fci);
-#if PHP_VERSION_ID < 70100
-			fci.function_table   = &ce->function_table;
-			fci.symbol_table     = NULL;
-#endif
-			fci.object           = obj;
-			fci.retval           = 0;
-			fci.param_count      = 0;
-			fci.params           = 0;
-			fci.no_separation    = 1;
-			ZVAL_NULL(&fci.function_name);
+	if (obj->handlers->get_constructor == zend_std_get_constructor) {
+		if (ic && ic->ce == obj->ce && ic->std_constructor) {
+			return ic->constructor;
+		}
 
-#if PHP_VERSION_ID < 70300
-			fcc.initialized      = 1;
-#endif
-			fcc.object           = obj;
-			fcc.called_scope     = ce;
-			fcc.calling_scope    = ce;
-			fcc.function_handler = ctor;
+		ctor = obj->ce->constructor;
+		if (!ctor || (ctor->common.fn_flags & ZEND_ACC_PUBLIC)) {
+			if (ic && ic->ce == obj->ce) {
+				ic->constructor     = ctor;
+				ic->std_constructor = 1;
+			}
 
-			return zend_fcall_info_call(&fci, &fcc, NULL, NULL);
+			return ctor;
 		}
 	}
 
-	return SUCCESS;
+	return obj->handlers->get_constructor(obj);
 }
 
 /**
- * Creates a new instance dynamically calling constructor with parameters
+ * Creates a new instance of class_name and calls its constructor, passing the
+ * elements of params as arguments if any
  */
-int zephir_create_instance_params(zval *return_value, const zval *class_name, zval *params)
+static int zephir_create_instance_ex(zval *return_value, const zval *class_name, zval *params, int fetch_type, zephir_instance_ic *ic)
 {
 	zend_class_entry *ce;
+	zend_function *ctor;
+	zend_object *obj;
+	zend_fcall_info fci;
+	zend_fcall_info_cache fcc;
+	zval argv[ZEPHIR_INSTANCE_MAX_ARGS];
+	int status;
 
 	if (Z_TYPE_P(class_name) != IS_STRING) {
 		zephir_throw_exception_string(spl_ce_RuntimeException, SL("Invalid class name"));
 		return FAILURE;
 	}
 
-	if (Z_TYPE_P(params) != IS_ARRAY) {
+	if (params && Z_TYPE_P(params) != IS_ARRAY) {
 		zephir_throw_exception_string(spl_ce_RuntimeException, SL("Instantiation parameters must be an array"));
 		return FAILURE;
 	}
 
-	ce = zend_fetch_class(Z_STR_P(class_name), ZEND_FETCH_CLASS_AUTO);
+	ce = zephir_fetch_instance_class(Z_STR_P(class_name), fetch_type, ic);
 	if (!ce) {
 		ZVAL_NULL(return_value);
 		return FAILURE;
 	}
 
-	if(UNEXPECTED(object_init_ex(return_value, ce) != SUCCESS)) {
-    	return FAILURE;
-    }
+	if (UNEXPECTED(object_init_ex(return_value, ce) != SUCCESS)) {
+		return FAILURE;
+	}
 
-	if (EXPECTED(Z_OBJ_HT_P(return_value)->get_constructor)) {
-		zend_object* obj    = Z_OBJ_P(return_value);
-		zend_function* ctor = Z_OBJ_HT_P(return_value)->get_constructor(obj);
-		if (ctor) {
-			int status;
-			zend_fcall_info fci;
-			zend_fcall_info_cache fcc;
+	obj  = Z_OBJ_P(return_value);
+	ctor = zephir_fetch_instance_constructor(obj, ic);
+	if (!ctor) {
+		return SUCCESS;
+	}
 
-			zend_class_entry* ce = Z_OBJCE_P(return_value);
+	ce = obj->ce;
 
-			fci.size             = sizeof(fci);
+	fci.size             = sizeof(fci);
 #if PHP_VERSION_ID < 70100
-			fci.function_table   = &ce->function_table;
-			fci.symbol_table     = NULL;
+	fci.function_table   = &ce->function_table;
+	fci.symbol_table     = NULL;
 #endif
-			fci.object           = obj;
-			fci.retval           = 0;
-			fci.param_count      = 0;
-			fci.params           = 0;
-			fci.no_separation    = 1;
-			ZVAL_NULL(&fci.function_name);
+	fci.object           = obj;
+	fci.retval           = 0;
+	fci.param_count      = 0;
+	fci.params           = 0;
+	fci.no_separation    = 1;
+	ZVAL_NULL(&fci.function_name);
 
 #if PHP_VERSION_ID < 70300
-			fcc.initialized      = 1;
+	fcc.initialized      = 1;
 #endif
-			fcc.object           = obj;
-			fcc.called_scope     = ce;
-			fcc.calling_scope    = ce;
-			fcc.function_handler = ctor;
-
-			zend_fcall_info_args_ex(&fci, fcc.function_handler, params);
-			status = zend_fcall_info_call(&fci, &fcc, NULL, NULL);
-			zend_fcall_info_args_clear(&fci, 1);
-			return status;
+	fcc.object           = obj;
+	fcc.called_scope     = ce;
+	fcc.calling_scope    = ce;
+	fcc.function_handler = ctor;
+
+	if (!params || !zend_hash_num_elements(Z_ARRVAL_P(params))) {
+		return zend_fcall_info_call(&fci, &fcc, NULL, NULL);
+	}
+
+	/**
+	 * Arrays without holes are passed from the stack: the values are copied
+	 * without touching their refcounts, zend_call_function() copies them into
+	 * the call frame. Arguments expected by reference need the references
+	 * built by zend_fcall_info_args_ex()
+	 */
+	if (EXPECTED(zend_hash_num_elements(Z_ARRVAL_P(params)) <= ZEPHIR_INSTANCE_MAX_ARGS && Z_ARRVAL_P(params)->nNumUsed == zend_hash_num_elements(Z_ARRVAL_P(params)))) {
+		Bucket *p = Z_ARRVAL_P(params)->arData;
+		uint32_t i, count = zend_hash_num_elements(Z_ARRVAL_P(params));
+
+		for (i = 0; i < count; ++i) {
+			if (UNEXPECTED(ARG_SHOULD_BE_SENT_BY_REF(ctor, i + 1))) {
+				break;
+			}
+
+			ZVAL_COPY_VALUE(&argv[i], &p[i].val);
+		}
+
+		if (EXPECTED(i == count)) {
+			fci.param_count = count;
+			fci.params      = argv;
+
+			return zend_fcall_info_call(&fci, &fcc, NULL, NULL);
 		}
 	}
 
-	return SUCCESS;
+	zend_fcall_info_args_ex(&fci, ctor, params);
+	status = zend_fcall_info_call(&fci, &fcc, NULL, NULL);
+	zend_fcall_info_args_clear(&fci, 1);
+
+	return status;
+}
+
+/**
+ * Creates a new instance dynamically. Call constructor without parameters
+ */
+int zephir_create_instance(zval *return_value, const zval *class_name)
+{
+	return zephir_create_instance_ex(return_value, class_name, NULL, ZEND_FETCH_CLASS_DEFAULT, NULL);
+}
+
+/**
+ * Creates a new instance dynamically calling constructor with parameters
+ */
+int zephir_create_instance_params(zval *return_value, const zval *class_name, zval *params)
+{
+	return zephir_create_instance_ex(return_value, class_name, params, ZEND_FETCH_CLASS_AUTO, NULL);
+}
+
+/**
+ * zephir_create_instance() resolving the class and its constructor through
+ * the cache of the call site
+ */
+int zephir_create_instance_ic(zval *return_value, const zval *class_name, zephir_instance_ic *ic)
+{
+	return zephir_create_instance_ex(return_value, class_name, NULL, ZEND_FETCH_CLASS_DEFAULT, ZEPHIR_GLOBAL(cache_enabled) ? ic : NULL);
+}
+
+/**
+ * zephir_create_instance_params() resolving the class and its constructor
+ * through the cache of the call site
+ */
+int zephir_create_instance_params_ic(zval *return_value, const zval *class_name, zval *params, zephir_instance_ic *ic)
+{
+	return zephir_create_instance_ex(return_value, class_name, params, ZEND_FETCH_CLASS_AUTO, ZEPHIR_GLOBAL(cache_enabled) ? ic : NULL);
 }
@@ -61,6 +61,91 @@ int zephir_fetch_property_zval(zval *result, zval *object, zval *property, int s
 int zephir_update_property_zval(zval *obj, const char *property_name, unsigned int property_length, zval *value);
 int zephir_update_property_zval_zval(zval *obj, zval *property, zval *value);
 
+/** Slot access to declared properties */
+
+/**
+ * Returns the slot of a property declared by ce, or NULL if the object is not
+ * exactly of that class, overrides the property handlers or the property was unset.
+ * The offset of the property is resolved once and cached in *offset
+ */
+static zend_always_inline zval *zephir_fetch_property_slot(zval *object, zend_class_entry *ce, uint32_t *offset, const char *property_name, size_t property_length, int write)
+{
+	zval *slot;
+
+	if (UNEXPECTED(Z_TYPE_P(object) != IS_OBJECT || Z_OBJCE_P(object) != ce)) {
+		return NULL;
+	}
+
+	if (write ? Z_OBJ_HT_P(object)->write_property != zend_std_write_property : Z_OBJ_HT_P(object)->read_property != zend_std_read_property) {
+		return NULL;
+	}
+
+	if (UNEXPECTED(!*offset)) {
+		zend_property_info *info = zend_hash_str_find_ptr(&ce->properties_info, property_name, property_length);
+		if (info && info->ce == ce && !(info->flags & ZEND_ACC_STATIC)) {
+			*offset = info->offset;
+		} else {
+			*offset = (uint32_t) -1;
+		}
+	}
+
+	if (UNEXPECTED(*offset == (uint32_t) -1)) {
+		return NULL;
+	}
+
+	slot = OBJ_PROP(Z_OBJ_P(object), *offset);
+
+	return EXPECTED(Z_TYPE_P(slot) != IS_UNDEF) ? slot : NULL;
+}
+
+/**
+ * Assigns a declared property through its slot, with the same separation of
+ * arrays as zephir_update_property_zval(). Returns 0 if the handlers must be used
+ */
+static zend_always_inline int zephir_update_property_slot_ex(zval *object, zend_class_entry *ce, uint32_t *offset, const char *property_name, size_t property_length, zval *value)
+{
+	zval garbage;
+	zval *slot = zephir_fetch_property_slot(object, ce, offset, property_name, property_length, 1);
+
+	if (UNEXPECTED(!slot || Z_ISREF_P(slot))) {
+		return 0;
+	}
+
+	ZVAL_COPY_VALUE(&garbage, slot);
+	if (Z_TYPE_P(value) == IS_ARRAY) {
+		ZVAL_ARR(slot, zend_array_dup(Z_ARR_P(value)));
+	} else {
+		ZVAL_DEREF(value);
+		ZVAL_COPY(slot, value);
+	}
+	zval_ptr_dtor(&garbage);
+
+	return 1;
+}
+
+#define zephir_read_property_slot(result, object, ce, property, flags) \
+	do { \
+		static uint32_t zephir_property_offset_ = 0; \
+		zval *zephir_property_slot_ = zephir_fetch_property_slot(object, ce, &zephir_property_offset_, property, 0); \
+		if (EXPECTED(zephir_property_slot_ != NULL)) { \
+			if (((flags) & PH_READONLY) == PH_READONLY) { \
+				ZVAL_COPY_VALUE(result, zephir_property_slot_); \
+			} else { \
+				ZVAL_COPY(result, zephir_property_slot_); \
+			} \
+		} else { \
+			zephir_read_property(result, object, property, flags); \
+		} \
+	} while (0)
+
+#define zephir_update_property_slot(object, ce, property, value) \
+	do { \
+		static uint32_t zephir_property_offset_ = 0; \
+		if (!zephir_update_property_slot_ex(object, ce, &zephir_property_offset_, property, value)) { \
+			zephir_update_property_zval(object, property, value); \
+		} \
+	} while (0)
+
 /** Updating array properties */
 int zephir_update_property_array(zval *object, const char *property, zend_uint property_length, const zval *index, zval *value);
 int zephir_update_property_array_string(zval *object, char *property, unsigned int property_length, char *index, unsigned int index_length, zval *value);
@@ -74,6 +159,63 @@ int zephir_unset_property_array(zval *object, char *property, unsigned int prope
 /** Static properties */
 int zephir_read_static_property_ce(zval *result, zend_class_entry *ce, const char *property, int len, int flags);
 int zephir_update_static_property_array_multi_ce(zend_class_entry *ce, const char *property, zend_uint property_length, zval *value, const char *types, int types_length, int types_count, ...);
+int zephir_update_static_property_array_multi_slot_ex(zend_class_entry *ce, zend_property_info **info, const char *property, zend_uint property_length, zval *value, const char *types, int types_length, int types_count, ...);
+
+/**
+ * Returns the slot of a static property declared by the internal class ce, or
+ * NULL if the engine must be used: the statics of ce are not initialized yet or
+ * the property is not declared by ce. The property is resolved once and cached
+ * in *info
+ */
+static zend_always_inline zval *zephir_fetch_static_property_slot(zend_class_entry *ce, zend_property_info **info, const char *property_name, size_t property_length)
+{
+	zval *slot;
+
+	if (UNEXPECTED(ce->type != ZEND_INTERNAL_CLASS || CE_STATIC_MEMBERS(ce) == NULL)) {
+		return NULL;
+	}
+
+#ifdef ZEND_ACC_CONSTANTS_UPDATED
+	if (UNEXPECTED(!(ce->ce_flags & ZEND_ACC_CONSTANTS_UPDATED))) {
+		return NULL;
+	}
+#endif
+
+	if (UNEXPECTED(!*info || (*info)->ce != ce)) {
+		zend_property_info *found = zend_hash_str_find_ptr(&ce->properties_info, property_name, property_length);
+		if (!found || found->ce != ce || !(found->flags & ZEND_ACC_STATIC)) {
+			return NULL;
+		}
+		*info = found;
+	}
+
+	slot = CE_STATIC_MEMBERS(ce) + (*info)->offset;
+	ZVAL_DEINDIRECT(slot);
+	ZVAL_DEREF(slot);
+
+	return slot;
+}
+
+#define zephir_read_static_property_slot(result, ce, property, flags) \
+	do { \
+		static zend_property_info *zephir_static_property_info_ = NULL; \
+		zval *zephir_static_property_slot_ = zephir_fetch_static_property_slot(ce, &zephir_static_property_info_, property); \
+		if (EXPECTED(zephir_static_property_slot_ != NULL)) { \
+			if (((flags) & PH_READONLY) == PH_READONLY) { \
+				ZVAL_COPY_VALUE(result, zephir_static_property_slot_); \
+			} else { \
+				ZVAL_COPY(result, zephir_static_property_slot_); \
+			} \
+		} else { \
+			zephir_read_static_property_ce(result, ce, property, flags); \
+		} \
+	} while (0)
+
+#define zephir_update_static_property_array_multi_slot(ce, property, value, ...) \
+	do { \
+		static zend_property_info *zephir_static_property_info_ = NULL; \
+		zephir_update_static_property_array_multi_slot_ex(ce, &zephir_static_property_info_, property, value, __VA_ARGS__); \
+	} while (0)
 
 /** Create closures */
 int zephir_create_closure_ex(zval *return_value, zval *this_ptr, zend_class_entry *ce, const char *method_name, zend_uint method_length);
@@ -81,6 +223,24 @@ int zephir_create_closure_ex(zval *return_value, zval *this_ptr, zend_class_entr
 /** Create instances */
 int zephir_create_instance(zval *return_value, const zval *class_name);
 int zephir_create_instance_params(zval *return_value, const zval *class_name, zval *params);
+int zephir_create_instance_ic(zval *return_value, const zval *class_name, zephir_instance_ic *ic);
+int zephir_create_instance_params_ic(zval *return_value, const zval *class_name, zval *params, zephir_instance_ic *ic);
+
+/*
+ * Instances created through the cache of the call site. The caches are static
+ * variables of the generated functions, so they are only used in non-ZTS builds.
+ */
+#ifndef ZTS
+#define ZEPHIR_CREATE_INSTANCE_IC(return_value, class_name, ic) \
+	zephir_create_instance_ic(return_value, class_name, ic)
+#define ZEPHIR_CREATE_INSTANCE_PARAMS_IC(return_value, class_name, params, ic) \
+	zephir_create_instance_params_ic(return_value, class_name, params, ic)
+#else
+#define ZEPHIR_CREATE_INSTANCE_IC(return_value, class_name, ic) \
+	zephir_create_instance(return_value, class_name)
+#define ZEPHIR_CREATE_INSTANCE_PARAMS_IC(return_value, class_name, params, ic) \
+	zephir_create_instance_params(return_value, class_name, params)
+#endif
 
 /** Increment/Decrement properties */
 #define zephir_property_incr(object, property) zephir_property_incr_decr(object, property, 1)
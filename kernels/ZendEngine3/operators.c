@@ -191,6 +191,34 @@ int zephir_compare_strict_long(zval *op1, long op2)
 	return 0;
 }
 
+/**
+ * Natural compare with double operandus on right
+ */
+int zephir_compare_strict_double(zval *op1, double op2)
+{
+	switch (Z_TYPE_P(op1)) {
+		case IS_LONG:
+			return (double) Z_LVAL_P(op1) == op2;
+		case IS_DOUBLE:
+			return Z_DVAL_P(op1) == op2;
+		case IS_NULL:
+			return 0 == op2;
+		case IS_TRUE:
+			return 0 != op2;
+		case IS_FALSE:
+			return 0 == op2;
+		default:
+			{
+				zval result, op2_tmp;
+				ZVAL_DOUBLE(&op2_tmp, op2);
+				is_equal_function(&result, op1, &op2_tmp);
+				return Z_TYPE(result) == IS_TRUE ? 1 : 0;
+			}
+	}
+
+	return 0;
+}
+
 /**
  * Natural compare with bool operandus on right
  */
@@ -558,6 +586,15 @@ int zephir_less_equal_long(zval *op1, long op2)
 	return Z_TYPE(result) == IS_TRUE;
 }
 
+int zephir_less_equal_double(zval *op1, double op2)
+{
+	zval result, op2_zval;
+	ZVAL_DOUBLE(&op2_zval, op2);
+
+	is_smaller_or_equal_function(&result, op1, &op2_zval);
+	return Z_TYPE(result) == IS_TRUE;
+}
+
 /**
  * Check if a zval is greater than a long value
  */
@@ -28,8 +28,8 @@
 #define zephir_make_printable_zval(expr, expr_copy) zend_make_printable_zval(expr, expr_copy);
 
 /** Strict comparing */
-#define ZEPHIR_IS_LONG(op1, op2)   ((Z_TYPE_P(op1) == IS_LONG && Z_LVAL_P(op1) == op2) || zephir_compare_strict_long(op1, op2))
-#define ZEPHIR_IS_DOUBLE(op1, op2) ((Z_TYPE_P(op1) == IS_DOUBLE && Z_DVAL_P(op1) == op2) || zephir_compare_strict_double(op1, op2))
+#define ZEPHIR_IS_LONG(op1, op2)   (Z_TYPE_P(op1) == IS_LONG ? Z_LVAL_P(op1) == op2 : zephir_compare_strict_long(op1, op2))
+#define ZEPHIR_IS_DOUBLE(op1, op2) (Z_TYPE_P(op1) == IS_DOUBLE ? Z_DVAL_P(op1) == op2 : zephir_compare_strict_double(op1, op2))
 #define ZEPHIR_IS_STRING(op1, op2) zephir_compare_strict_string(op1, op2, strlen(op2))
 
 #define ZEPHIR_IS_LONG_IDENTICAL(op1, op2)   (Z_TYPE_P(op1) == IS_LONG && Z_LVAL_P(op1) == op2)
@@ -57,21 +57,24 @@
 #define ZEPHIR_IS_NOT_SCALAR(var)  (Z_TYPE_P(var) == IS_NULL || Z_TYPE_P(var) == IS_ARRAY || Z_TYPE_P(var) == IS_OBJECT || Z_TYPE_P(var) == IS_RESOURCE)
 
 /** Equals/Identical */
-#define ZEPHIR_IS_EQUAL(op1, op2)      zephir_is_equal(op1, op2)
+#define ZEPHIR_IS_EQUAL(op1, op2)      zephir_fast_is_equal(op1, op2)
 #define ZEPHIR_IS_IDENTICAL(op1, op2)  zephir_is_identical(op1, op2)
 
-/** Greater/Smaller equals */
-#define ZEPHIR_LE(op1, op2)       zephir_less_equal(op1, op2)
-#define ZEPHIR_LE_LONG(op1, op2)  ((Z_TYPE_P(op1) == IS_LONG && Z_LVAL_P(op1) <= op2) || zephir_less_equal_long(op1, op2))
-#define ZEPHIR_LE_DOUBLE(op1, op2)  ((Z_TYPE_P(op1) == IS_DOUBLE && Z_DVAL_P(op1) <= op2) || zephir_less_equal_double(op1, op2))
-#define ZEPHIR_GE(op1, op2)       zephir_greater_equal(op1, op2)
-#define ZEPHIR_GE_LONG(op1, op2)  zephir_greater_equal_long(op1, op2)
-#define ZEPHIR_LT(op1, op2)       ((Z_TYPE_P(op1) == IS_LONG && Z_TYPE_P(op2) == IS_LONG) ? Z_LVAL_P(op1) < Z_LVAL_P(op2) : zephir_less(op1, op2))
-#define ZEPHIR_LT_LONG(op1, op2)  ((Z_TYPE_P(op1) == IS_LONG && Z_LVAL_P(op1) < op2) || zephir_less_long(op1, op2))
-#define ZEPHIR_LT_DOUBLE(op1, op2)  ((Z_TYPE_P(op1) == IS_DOUBLE && Z_DVAL_P(op1) < op2) || zephir_less_double(op1, op2))
-#define ZEPHIR_GT(op1, op2)       zephir_greater(op1, op2)
-#define ZEPHIR_GT_LONG(op1, op2)  ((Z_TYPE_P(op1) == IS_LONG && Z_LVAL_P(op1) > op2) || zephir_greater_long(op1, op2))
-#define ZEPHIR_GT_DOUBLE(op1, op2)  ((Z_TYPE_P(op1) == IS_DOUBLE && Z_DVAL_P(op1) > op2) || zephir_greater_double(op1, op2))
+/**
+ * Greater/Smaller equals. The operand of the type the macro is named after
+ * is compared natively, anything else goes through compare_function()
+ */
+#define ZEPHIR_LE(op1, op2)       zephir_fast_less_equal(op1, op2)
+#define ZEPHIR_LE_LONG(op1, op2)  (Z_TYPE_P(op1) == IS_LONG ? Z_LVAL_P(op1) <= op2 : zephir_less_equal_long(op1, op2))
+#define ZEPHIR_LE_DOUBLE(op1, op2)  (Z_TYPE_P(op1) == IS_DOUBLE ? Z_DVAL_P(op1) <= op2 : zephir_less_equal_double(op1, op2))
+#define ZEPHIR_GE(op1, op2)       zephir_fast_greater_equal(op1, op2)
+#define ZEPHIR_GE_LONG(op1, op2)  (Z_TYPE_P(op1) == IS_LONG ? Z_LVAL_P(op1) >= op2 : zephir_greater_equal_long(op1, op2))
+#define ZEPHIR_LT(op1, op2)       zephir_fast_less(op1, op2)
+#define ZEPHIR_LT_LONG(op1, op2)  (Z_TYPE_P(op1) == IS_LONG ? Z_LVAL_P(op1) < op2 : zephir_less_long(op1, op2))
+#define ZEPHIR_LT_DOUBLE(op1, op2)  (Z_TYPE_P(op1) == IS_DOUBLE ? Z_DVAL_P(op1) < op2 : zephir_less_double(op1, op2))
+#define ZEPHIR_GT(op1, op2)       zephir_fast_greater(op1, op2)
+#define ZEPHIR_GT_LONG(op1, op2)  (Z_TYPE_P(op1) == IS_LONG ? Z_LVAL_P(op1) > op2 : zephir_greater_long(op1, op2))
+#define ZEPHIR_GT_DOUBLE(op1, op2)  (Z_TYPE_P(op1) == IS_DOUBLE ? Z_DVAL_P(op1) > op2 : zephir_greater_double(op1, op2))
 
 #define ZEPHIR_STRING_OFFSET(op1, index) ((index >= 0 && index < Z_STRLEN_P(op1)) ? Z_STRVAL_P(op1)[index] : '\0')
 
@@ -125,6 +128,7 @@ int zephir_greater_double(zval *op1, double op2);
 
 int zephir_less_equal(zval *op1, zval *op2);
 int zephir_less_equal_long(zval *op1, long op2);
+int zephir_less_equal_double(zval *op1, double op2);
 
 int zephir_greater_equal(zval *op1, zval *op2);
 int zephir_greater_equal_long(zval *op1, long op2);
@@ -148,14 +152,112 @@ long zephir_safe_mod_long_zval(long op1, zval *op2);
 long zephir_safe_mod_double_zval(double op1, zval *op2);
 
 #define zephir_get_numberval(z) (Z_TYPE_P(z) == IS_LONG ? Z_LVAL_P(z) : zephir_get_doubleval(z))
-#define zephir_get_intval(z) (Z_TYPE_P(z) == IS_LONG ? Z_LVAL_P(z) : zephir_get_intval_ex(z))
-#define zephir_get_doubleval(z) (Z_TYPE_P(z) == IS_DOUBLE ? Z_DVAL_P(z) : zephir_get_doubleval_ex(z))
-#define zephir_get_boolval(z) (Z_TYPE_P(z) == IS_TRUE ? 1 : (Z_TYPE_P(z) == IS_FALSE ? 0 : zephir_get_boolval_ex(z)))
-#define zephir_get_charval(z) (Z_TYPE_P(z) == IS_LONG ? Z_LVAL_P(z) : zephir_get_charval_ex(z))
+#define zephir_get_intval(z) (EXPECTED(Z_TYPE_P(z) == IS_LONG) ? Z_LVAL_P(z) : zephir_get_intval_ex(z))
+#define zephir_get_doubleval(z) (EXPECTED(Z_TYPE_P(z) == IS_DOUBLE) ? Z_DVAL_P(z) : zephir_get_doubleval_ex(z))
+#define zephir_get_boolval(z) (EXPECTED(Z_TYPE_P(z) == IS_TRUE) ? 1 : (EXPECTED(Z_TYPE_P(z) == IS_FALSE) ? 0 : zephir_get_boolval_ex(z)))
+#define zephir_get_charval(z) (EXPECTED(Z_TYPE_P(z) == IS_LONG) ? Z_LVAL_P(z) : zephir_get_charval_ex(z))
 
 #define zephir_add_function(result, left, right) fast_add_function(result, left, right)
-#define zephir_sub_function(result, left, right) sub_function(result, left, right)
+#define zephir_sub_function(result, left, right) fast_sub_function(result, left, right)
 #define zephir_pow_function(result, op1, op2) pow_function(result, op1, op2)
+
+/**
+ * Multiplies two zvals, longs and doubles natively like the engine's
+ * ZEND_MUL handler, anything else through mul_function()
+ */
+static zend_always_inline int zephir_mul_function(zval *result, zval *op1, zval *op2)
+{
+	if (EXPECTED(Z_TYPE_P(op1) == IS_LONG)) {
+		if (EXPECTED(Z_TYPE_P(op2) == IS_LONG)) {
+			zend_long lval;
+			double dval;
+			int overflow;
+
+			ZEND_SIGNED_MULTIPLY_LONG(Z_LVAL_P(op1), Z_LVAL_P(op2), lval, dval, overflow);
+			if (UNEXPECTED(overflow)) {
+				ZVAL_DOUBLE(result, dval);
+			} else {
+				ZVAL_LONG(result, lval);
+			}
+			return SUCCESS;
+		}
+		if (Z_TYPE_P(op2) == IS_DOUBLE) {
+			ZVAL_DOUBLE(result, ((double) Z_LVAL_P(op1)) * Z_DVAL_P(op2));
+			return SUCCESS;
+		}
+	} else if (EXPECTED(Z_TYPE_P(op1) == IS_DOUBLE)) {
+		if (EXPECTED(Z_TYPE_P(op2) == IS_DOUBLE)) {
+			ZVAL_DOUBLE(result, Z_DVAL_P(op1) * Z_DVAL_P(op2));
+			return SUCCESS;
+		}
+		if (Z_TYPE_P(op2) == IS_LONG) {
+			ZVAL_DOUBLE(result, Z_DVAL_P(op1) * ((double) Z_LVAL_P(op2)));
+			return SUCCESS;
+		}
+	}
+
+	return mul_function(result, op1, op2);
+}
+
+/**
+ * Native comparison of two zvals holding longs or doubles, like the fast paths
+ * of the engine's comparison handlers. Returns from the enclosing function.
+ */
+#define ZEPHIR_FAST_NUMERIC_COMPARE(op1, op2, op) \
+	if (EXPECTED(Z_TYPE_P(op1) == IS_LONG)) { \
+		if (EXPECTED(Z_TYPE_P(op2) == IS_LONG)) { \
+			return Z_LVAL_P(op1) op Z_LVAL_P(op2); \
+		} \
+		if (Z_TYPE_P(op2) == IS_DOUBLE) { \
+			return ((double) Z_LVAL_P(op1)) op Z_DVAL_P(op2); \
+		} \
+	} else if (EXPECTED(Z_TYPE_P(op1) == IS_DOUBLE)) { \
+		if (EXPECTED(Z_TYPE_P(op2) == IS_DOUBLE)) { \
+			return Z_DVAL_P(op1) op Z_DVAL_P(op2); \
+		} \
+		if (Z_TYPE_P(op2) == IS_LONG) { \
+			return Z_DVAL_P(op1) op ((double) Z_LVAL_P(op2)); \
+		} \
+	}
+
+static zend_always_inline int zephir_fast_is_equal(zval *op1, zval *op2)
+{
+	ZEPHIR_FAST_NUMERIC_COMPARE(op1, op2, ==);
+
+	if (Z_TYPE_P(op1) == IS_STRING && Z_TYPE_P(op2) == IS_STRING) {
+		return zend_fast_equal_strings(Z_STR_P(op1), Z_STR_P(op2));
+	}
+
+	return zephir_is_equal(op1, op2);
+}
+
+static zend_always_inline int zephir_fast_less(zval *op1, zval *op2)
+{
+	ZEPHIR_FAST_NUMERIC_COMPARE(op1, op2, <);
+
+	return zephir_less(op1, op2);
+}
+
+static zend_always_inline int zephir_fast_less_equal(zval *op1, zval *op2)
+{
+	ZEPHIR_FAST_NUMERIC_COMPARE(op1, op2, <=);
+
+	return zephir_less_equal(op1, op2);
+}
+
+static zend_always_inline int zephir_fast_greater(zval *op1, zval *op2)
+{
+	ZEPHIR_FAST_NUMERIC_COMPARE(op1, op2, >);
+
+	return zephir_greater(op1, op2);
+}
+
+static zend_always_inline int zephir_fast_greater_equal(zval *op1, zval *op2)
+{
+	ZEPHIR_FAST_NUMERIC_COMPARE(op1, op2, >=);
+
+	return zephir_greater_equal(op1, op2);
+}
 #define zephir_increment(var) increment_function(var)
 #define zephir_decrement(var) decrement_function(var)
 
@@ -206,7 +308,7 @@ long zephir_safe_mod_double_zval(double op1, zval *op2);
 	{ \
 		int use_copy_right; \
 		zval right_tmp; \
-		if (Z_TYPE_P(right) == IS_STRING) { \
+		if (EXPECTED(Z_TYPE_P(right) == IS_STRING)) { \
 			ZEPHIR_CPY_WRT(left, right); \
 		} else { \
 			use_copy_right = zephir_make_printable_zval(right, &right_tmp); \
@@ -0,0 +1,512 @@
+/*
+ * This file is part of the Zephir.
+ *
+ * (c) Zephir Team <team@zephir-lang.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code. If you did not receive
+ * a copy of the license it is available through the world-wide-web at the
+ * following url: https://docs.zephir-lang.com/en/latest/license
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <ctype.h>
+
+#include <php.h>
+#include "php_ext.h"
+
+#include "kernel/simd.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define ZEPHIR_SIMD_SSE2 1
+# include <emmintrin.h>
+#endif
+
+/* The CRC32 instructions of ARMv8 use the polynomial of crc32(), the SSE4.2 ones do not */
+#if defined(__aarch64__) && defined(__linux__) && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 6))
+# define ZEPHIR_SIMD_ARM_CRC32 1
+# include <arm_acle.h>
+# include <sys/auxv.h>
+# include <asm/hwcap.h>
+# ifdef __clang__
+#  define ZEPHIR_TARGET_CRC32 __attribute__((target("crc")))
+# else
+#  define ZEPHIR_TARGET_CRC32 __attribute__((target("+crc")))
+# endif
+#endif
+
+#if defined(ZEPHIR_SIMD_SSE2) && (defined(__x86_64__) || defined(__i386__)) && \
+	(defined(__clang__) || (defined(__GNUC__) && (__GNUC__ * 100 + __GNUC_MINOR__) >= 409))
+# define ZEPHIR_SIMD_AVX2 1
+# include <immintrin.h>
+# define ZEPHIR_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+static zend_always_inline unsigned int zephir_simd_ctz(unsigned int mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctz(mask);
+#else
+	unsigned int n = 0;
+
+	while (!(mask & 1)) {
+		mask >>= 1;
+		n++;
+	}
+
+	return n;
+#endif
+}
+
+/**
+ * ASCII letters can be converted without calling tolower()/toupper() unless
+ * the locale maps them differently (i.e. the Turkish dotted and dotless i)
+ */
+static zend_always_inline int zephir_simd_ascii_case(void)
+{
+	return tolower('I') == 'i' && toupper('i') == 'I';
+}
+
+static size_t zephir_span_range_scalar(const unsigned char *str, size_t length, unsigned char low, unsigned char high, unsigned char except_low, unsigned char except_high)
+{
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		unsigned char ch = str[i];
+		if (ch < low || ch > high || (ch >= except_low && ch <= except_high)) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+static size_t zephir_span_alnum_scalar(const unsigned char *str, size_t length)
+{
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		unsigned char ch = str[i];
+		if (!((ch >= '0' && ch <= '9') || ((ch | 0x20) >= 'a' && (ch | 0x20) <= 'z'))) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+static size_t zephir_span_not_in_scalar(const unsigned char *str, size_t length, const unsigned char *set, size_t set_length)
+{
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		if (memchr(set, str[i], set_length)) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+static void zephir_change_case_scalar(unsigned char *dst, const unsigned char *src, size_t length, int upper)
+{
+	size_t i;
+
+	if (upper) {
+		for (i = 0; i < length; i++) {
+			dst[i] = toupper(src[i]);
+		}
+	} else {
+		for (i = 0; i < length; i++) {
+			dst[i] = tolower(src[i]);
+		}
+	}
+}
+
+/**
+ * The differences of every byte are accumulated and only tested at the end,
+ * so the time taken depends on the length alone
+ */
+static int zephir_diff_scalar(const unsigned char *a, const unsigned char *b, size_t length)
+{
+	uint64_t words = 0, wa, wb;
+	unsigned char bytes = 0;
+	size_t i = 0;
+
+	for (; i + 8 <= length; i += 8) {
+		memcpy(&wa, a + i, 8);
+		memcpy(&wb, b + i, 8);
+		words |= wa ^ wb;
+	}
+
+	for (; i < length; i++) {
+		bytes |= a[i] ^ b[i];
+	}
+
+	return (words | bytes) != 0;
+}
+
+/* Slicing-by-8 tables of the reflected CRC-32 polynomial, filled by zephir_simd_init() */
+static uint32_t zephir_crc32_tables[8][256];
+
+static void zephir_crc32_init_tables(void)
+{
+	uint32_t i, j, crc;
+
+	for (i = 0; i < 256; i++) {
+		crc = i;
+		for (j = 0; j < 8; j++) {
+			crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+		}
+		zephir_crc32_tables[0][i] = crc;
+	}
+
+	for (i = 0; i < 256; i++) {
+		for (j = 1; j < 8; j++) {
+			crc = zephir_crc32_tables[j - 1][i];
+			zephir_crc32_tables[j][i] = (crc >> 8) ^ zephir_crc32_tables[0][crc & 0xFF];
+		}
+	}
+}
+
+static uint32_t zephir_crc32_scalar(uint32_t crc, const unsigned char *p, size_t length)
+{
+	const uint32_t (*t)[256] = (const uint32_t (*)[256]) zephir_crc32_tables;
+
+#ifndef WORDS_BIGENDIAN
+	uint32_t one, two;
+
+	for (; length >= 8; p += 8, length -= 8) {
+		memcpy(&one, p, 4);
+		memcpy(&two, p + 4, 4);
+		one ^= crc;
+		crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+			t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^ t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+	}
+#endif
+
+	for (; length; p++, length--) {
+		crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xFF];
+	}
+
+	return crc;
+}
+
+#ifdef ZEPHIR_SIMD_SSE2
+/**
+ * Converts the bytes >= 0x80 of a block already converted as ASCII, as the
+ * locale may map them as well (used by the SSE2 and AVX2 kernels)
+ */
+static void zephir_change_case_high(unsigned char *dst, size_t length, int upper)
+{
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		if (dst[i] & 0x80) {
+			dst[i] = upper ? toupper(dst[i]) : tolower(dst[i]);
+		}
+	}
+}
+
+/* Bytes of x between low and low + range, as unsigned numbers */
+static zend_always_inline __m128i zephir_sse2_in_range(__m128i x, __m128i low, __m128i range)
+{
+	__m128i d = _mm_sub_epi8(x, low);
+	return _mm_cmpeq_epi8(_mm_min_epu8(d, range), d);
+}
+
+static size_t zephir_span_range_sse2(const unsigned char *str, size_t length, unsigned char low, unsigned char high, unsigned char except_low, unsigned char except_high)
+{
+	size_t i = 0;
+	const __m128i vlow = _mm_set1_epi8((char) low), vrange = _mm_set1_epi8((char) (high - low));
+	const __m128i vexcept = _mm_set1_epi8((char) except_low), vexcept_range = _mm_set1_epi8((char) (except_high - except_low));
+
+	for (; i + 16 <= length; i += 16) {
+		__m128i x = _mm_loadu_si128((const __m128i *) (str + i));
+		__m128i ok = _mm_andnot_si128(zephir_sse2_in_range(x, vexcept, vexcept_range), zephir_sse2_in_range(x, vlow, vrange));
+		unsigned int mask = (unsigned int) _mm_movemask_epi8(ok);
+		if (mask != 0xFFFF) {
+			return i + zephir_simd_ctz(~mask);
+		}
+	}
+
+	return i + zephir_span_range_scalar(str + i, length - i, low, high, except_low, except_high);
+}
+
+static size_t zephir_span_alnum_sse2(const unsigned char *str, size_t length)
+{
+	size_t i = 0;
+	const __m128i digit = _mm_set1_epi8('0'), digit_range = _mm_set1_epi8(9);
+	const __m128i alpha = _mm_set1_epi8('a'), alpha_range = _mm_set1_epi8(25), fold = _mm_set1_epi8(0x20);
+
+	for (; i + 16 <= length; i += 16) {
+		__m128i x = _mm_loadu_si128((const __m128i *) (str + i));
+		__m128i ok = _mm_or_si128(zephir_sse2_in_range(x, digit, digit_range), zephir_sse2_in_range(_mm_or_si128(x, fold), alpha, alpha_range));
+		unsigned int mask = (unsigned int) _mm_movemask_epi8(ok);
+		if (mask != 0xFFFF) {
+			return i + zephir_simd_ctz(~mask);
+		}
+	}
+
+	return i + zephir_span_alnum_scalar(str + i, length - i);
+}
+
+static size_t zephir_span_not_in_sse2(const unsigned char *str, size_t length, const unsigned char *set, size_t set_length)
+{
+	size_t i = 0;
+	__m128i c0, c1, c2, c3;
+
+	if (set_length == 0 || set_length > 4) {
+		return zephir_span_not_in_scalar(str, length, set, set_length);
+	}
+
+	/* Unused comparands repeat the first byte of the set */
+	c0 = _mm_set1_epi8((char) set[0]);
+	c1 = _mm_set1_epi8((char) set[set_length > 1 ? 1 : 0]);
+	c2 = _mm_set1_epi8((char) set[set_length > 2 ? 2 : 0]);
+	c3 = _mm_set1_epi8((char) set[set_length > 3 ? 3 : 0]);
+
+	for (; i + 16 <= length; i += 16) {
+		__m128i x = _mm_loadu_si128((const __m128i *) (str + i));
+		__m128i found = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(x, c0), _mm_cmpeq_epi8(x, c1)),
+			_mm_or_si128(_mm_cmpeq_epi8(x, c2), _mm_cmpeq_epi8(x, c3))
+		);
+		unsigned int mask = (unsigned int) _mm_movemask_epi8(found);
+		if (mask) {
+			return i + zephir_simd_ctz(mask);
+		}
+	}
+
+	return i + zephir_span_not_in_scalar(str + i, length - i, set, set_length);
+}
+
+static void zephir_change_case_sse2(unsigned char *dst, const unsigned char *src, size_t length, int upper)
+{
+	size_t i = 0;
+	const __m128i low = _mm_set1_epi8(upper ? 'a' : 'A'), range = _mm_set1_epi8(25), flip = _mm_set1_epi8(0x20);
+
+	if (!zephir_simd_ascii_case()) {
+		zephir_change_case_scalar(dst, src, length, upper);
+		return;
+	}
+
+	for (; i + 16 <= length; i += 16) {
+		__m128i x = _mm_loadu_si128((const __m128i *) (src + i));
+		__m128i letters = _mm_and_si128(zephir_sse2_in_range(x, low, range), flip);
+		_mm_storeu_si128((__m128i *) (dst + i), _mm_xor_si128(x, letters));
+		if (_mm_movemask_epi8(x)) {
+			zephir_change_case_high(dst + i, 16, upper);
+		}
+	}
+
+	zephir_change_case_scalar(dst + i, src + i, length - i, upper);
+}
+
+static int zephir_diff_sse2(const unsigned char *a, const unsigned char *b, size_t length)
+{
+	size_t i = 0;
+	__m128i diff = _mm_setzero_si128();
+
+	for (; i + 16 <= length; i += 16) {
+		diff = _mm_or_si128(diff, _mm_xor_si128(_mm_loadu_si128((const __m128i *) (a + i)), _mm_loadu_si128((const __m128i *) (b + i))));
+	}
+
+	/* No short-circuit: the tail is compared whatever the blocks gave */
+	return (_mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) != 0xFFFF) | zephir_diff_scalar(a + i, b + i, length - i);
+}
+#endif
+
+#ifdef ZEPHIR_SIMD_AVX2
+static zend_always_inline ZEPHIR_TARGET_AVX2 __m256i zephir_avx2_in_range(__m256i x, __m256i low, __m256i range)
+{
+	__m256i d = _mm256_sub_epi8(x, low);
+	return _mm256_cmpeq_epi8(_mm256_min_epu8(d, range), d);
+}
+
+static ZEPHIR_TARGET_AVX2 size_t zephir_span_range_avx2(const unsigned char *str, size_t length, unsigned char low, unsigned char high, unsigned char except_low, unsigned char except_high)
+{
+	size_t i = 0;
+	const __m256i vlow = _mm256_set1_epi8((char) low), vrange = _mm256_set1_epi8((char) (high - low));
+	const __m256i vexcept = _mm256_set1_epi8((char) except_low), vexcept_range = _mm256_set1_epi8((char) (except_high - except_low));
+
+	for (; i + 32 <= length; i += 32) {
+		__m256i x = _mm256_loadu_si256((const __m256i *) (str + i));
+		__m256i ok = _mm256_andnot_si256(zephir_avx2_in_range(x, vexcept, vexcept_range), zephir_avx2_in_range(x, vlow, vrange));
+		unsigned int mask = (unsigned int) _mm256_movemask_epi8(ok);
+		if (mask != 0xFFFFFFFF) {
+			return i + zephir_simd_ctz(~mask);
+		}
+	}
+
+	return i + zephir_span_range_sse2(str + i, length - i, low, high, except_low, except_high);
+}
+
+static ZEPHIR_TARGET_AVX2 size_t zephir_span_alnum_avx2(const unsigned char *str, size_t length)
+{
+	size_t i = 0;
+	const __m256i digit = _mm256_set1_epi8('0'), digit_range = _mm256_set1_epi8(9);
+	const __m256i alpha = _mm256_set1_epi8('a'), alpha_range = _mm256_set1_epi8(25), fold = _mm256_set1_epi8(0x20);
+
+	for (; i + 32 <= length; i += 32) {
+		__m256i x = _mm256_loadu_si256((const __m256i *) (str + i));
+		__m256i ok = _mm256_or_si256(zephir_avx2_in_range(x, digit, digit_range), zephir_avx2_in_range(_mm256_or_si256(x, fold), alpha, alpha_range));
+		unsigned int mask = (unsigned int) _mm256_movemask_epi8(ok);
+		if (mask != 0xFFFFFFFF) {
+			return i + zephir_simd_ctz(~mask);
+		}
+	}
+
+	return i + zephir_span_alnum_sse2(str + i, length - i);
+}
+
+static ZEPHIR_TARGET_AVX2 size_t zephir_span_not_in_avx2(const unsigned char *str, size_t length, const unsigned char *set, size_t set_length)
+{
+	size_t i = 0;
+	__m256i c0, c1, c2, c3;
+
+	if (set_length == 0 || set_length > 4) {
+		return zephir_span_not_in_scalar(str, length, set, set_length);
+	}
+
+	c0 = _mm256_set1_epi8((char) set[0]);
+	c1 = _mm256_set1_epi8((char) set[set_length > 1 ? 1 : 0]);
+	c2 = _mm256_set1_epi8((char) set[set_length > 2 ? 2 : 0]);
+	c3 = _mm256_set1_epi8((char) set[set_length > 3 ? 3 : 0]);
+
+	for (; i + 32 <= length; i += 32) {
+		__m256i x = _mm256_loadu_si256((const __m256i *) (str + i));
+		__m256i found = _mm256_or_si256(
+			_mm256_or_si256(_mm256_cmpeq_epi8(x, c0), _mm256_cmpeq_epi8(x, c1)),
+			_mm256_or_si256(_mm256_cmpeq_epi8(x, c2), _mm256_cmpeq_epi8(x, c3))
+		);
+		unsigned int mask = (unsigned int) _mm256_movemask_epi8(found);
+		if (mask) {
+			return i + zephir_simd_ctz(mask);
+		}
+	}
+
+	return i + zephir_span_not_in_sse2(str + i, length - i, set, set_length);
+}
+
+static ZEPHIR_TARGET_AVX2 void zephir_change_case_avx2(unsigned char *dst, const unsigned char *src, size_t length, int upper)
+{
+	size_t i = 0;
+	const __m256i low = _mm256_set1_epi8(upper ? 'a' : 'A'), range = _mm256_set1_epi8(25), flip = _mm256_set1_epi8(0x20);
+
+	if (!zephir_simd_ascii_case()) {
+		zephir_change_case_scalar(dst, src, length, upper);
+		return;
+	}
+
+	for (; i + 32 <= length; i += 32) {
+		__m256i x = _mm256_loadu_si256((const __m256i *) (src + i));
+		__m256i letters = _mm256_and_si256(zephir_avx2_in_range(x, low, range), flip);
+		_mm256_storeu_si256((__m256i *) (dst + i), _mm256_xor_si256(x, letters));
+		if (_mm256_movemask_epi8(x)) {
+			zephir_change_case_high(dst + i, 32, upper);
+		}
+	}
+
+	zephir_change_case_sse2(dst + i, src + i, length - i, upper);
+}
+
+static ZEPHIR_TARGET_AVX2 int zephir_diff_avx2(const unsigned char *a, const unsigned char *b, size_t length)
+{
+	size_t i = 0;
+	__m256i diff = _mm256_setzero_si256();
+
+	for (; i + 32 <= length; i += 32) {
+		diff = _mm256_or_si256(diff, _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (a + i)), _mm256_loadu_si256((const __m256i *) (b + i))));
+	}
+
+	return !_mm256_testz_si256(diff, diff) | zephir_diff_sse2(a + i, b + i, length - i);
+}
+#endif
+
+#ifdef ZEPHIR_SIMD_ARM_CRC32
+static ZEPHIR_TARGET_CRC32 uint32_t zephir_crc32_arm(uint32_t crc, const unsigned char *p, size_t length)
+{
+	uint64_t word;
+
+	for (; length >= 8; p += 8, length -= 8) {
+		memcpy(&word, p, 8);
+		crc = __crc32d(crc, word);
+	}
+
+	for (; length; p++, length--) {
+		crc = __crc32b(crc, *p);
+	}
+
+	return crc;
+}
+#endif
+
+#ifdef ZEPHIR_SIMD_SSE2
+zephir_simd_kernels zephir_simd = {
+	zephir_span_range_sse2,
+	zephir_span_alnum_sse2,
+	zephir_span_not_in_sse2,
+	zephir_change_case_sse2,
+	zephir_diff_sse2,
+	zephir_crc32_scalar
+};
+#else
+zephir_simd_kernels zephir_simd = {
+	zephir_span_range_scalar,
+	zephir_span_alnum_scalar,
+	zephir_span_not_in_scalar,
+	zephir_change_case_scalar,
+	zephir_diff_scalar,
+	zephir_crc32_scalar
+};
+#endif
+
+/**
+ * Selects the widest kernels supported by the CPU
+ */
+void zephir_simd_init(void)
+{
+	zephir_crc32_init_tables();
+
+#ifdef ZEPHIR_SIMD_ARM_CRC32
+	if (getauxval(AT_HWCAP) & HWCAP_CRC32) {
+		zephir_simd.crc32 = zephir_crc32_arm;
+	}
+#endif
+#ifdef ZEPHIR_SIMD_AVX2
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		zephir_simd.span_range  = zephir_span_range_avx2;
+		zephir_simd.span_alnum  = zephir_span_alnum_avx2;
+		zephir_simd.span_not_in = zephir_span_not_in_avx2;
+		zephir_simd.change_case = zephir_change_case_avx2;
+		zephir_simd.diff        = zephir_diff_avx2;
+	}
+#endif
+}
+
+/**
+ * Returns the instruction set of the kernels in use
+ */
+const char *zephir_simd_name(void)
+{
+#ifdef ZEPHIR_SIMD_AVX2
+	if (zephir_simd.span_range == zephir_span_range_avx2) {
+		return "avx2";
+	}
+#endif
+#ifdef ZEPHIR_SIMD_ARM_CRC32
+	if (zephir_simd.crc32 == zephir_crc32_arm) {
+		return "armv8 crc32";
+	}
+#endif
+#ifdef ZEPHIR_SIMD_SSE2
+	return "sse2";
+#else
+	return "scalar";
+#endif
+}
@@ -0,0 +1,90 @@
+/*
+ * This file is part of the Zephir.
+ *
+ * (c) Zephir Team <team@zephir-lang.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code. If you did not receive
+ * a copy of the license it is available through the world-wide-web at the
+ * following url: https://docs.zephir-lang.com/en/latest/license
+ */
+
+#ifndef ZEPHIR_KERNEL_SIMD_H
+#define ZEPHIR_KERNEL_SIMD_H
+
+#include <php.h>
+#include <Zend/zend.h>
+
+/**
+ * Byte scanning kernels used by the string functions. They are vectorized
+ * with SSE2 on x86, upgraded to AVX2 at module startup when the CPU supports
+ * it, and scalar elsewhere. crc32 uses slicing-by-8, or the CRC32
+ * instructions of ARMv8 when present.
+ */
+typedef struct _zephir_simd_kernels {
+	size_t (*span_range)(const unsigned char *str, size_t length, unsigned char low, unsigned char high, unsigned char except_low, unsigned char except_high);
+	size_t (*span_alnum)(const unsigned char *str, size_t length);
+	size_t (*span_not_in)(const unsigned char *str, size_t length, const unsigned char *set, size_t set_length);
+	void (*change_case)(unsigned char *dst, const unsigned char *src, size_t length, int upper);
+	int (*diff)(const unsigned char *a, const unsigned char *b, size_t length);
+	uint32_t (*crc32)(uint32_t crc, const unsigned char *str, size_t length);
+} zephir_simd_kernels;
+
+extern zephir_simd_kernels zephir_simd;
+
+void zephir_simd_init(void);
+const char *zephir_simd_name(void);
+
+/**
+ * Returns the length of the leading bytes of str between low and high but
+ * not between except_low and except_high
+ */
+static zend_always_inline size_t zephir_simd_span_range(const char *str, size_t length, unsigned char low, unsigned char high, unsigned char except_low, unsigned char except_high)
+{
+	return zephir_simd.span_range((const unsigned char *) str, length, low, high, except_low, except_high);
+}
+
+/**
+ * Returns the length of the leading ASCII alphanumeric bytes of str
+ */
+static zend_always_inline size_t zephir_simd_span_alnum(const char *str, size_t length)
+{
+	return zephir_simd.span_alnum((const unsigned char *) str, length);
+}
+
+/**
+ * Returns the length of the leading bytes of str not found in set (like strcspn)
+ */
+static zend_always_inline size_t zephir_simd_span_not_in(const char *str, size_t length, const char *set, size_t set_length)
+{
+	return zephir_simd.span_not_in((const unsigned char *) str, length, (const unsigned char *) set, set_length);
+}
+
+/**
+ * Copies src to dst converting it to lower or upper case like php_strtolower()
+ * and php_strtoupper(). dst may be src.
+ */
+static zend_always_inline void zephir_simd_change_case(char *dst, const char *src, size_t length, int upper)
+{
+	zephir_simd.change_case((unsigned char *) dst, (const unsigned char *) src, length, upper);
+}
+
+/**
+ * Returns whether the first length bytes of a and b differ, in a time that
+ * does not depend on their contents
+ */
+static zend_always_inline int zephir_simd_diff(const char *a, const char *b, size_t length)
+{
+	return zephir_simd.diff((const unsigned char *) a, (const unsigned char *) b, length);
+}
+
+/**
+ * Updates a crc32() checksum with length bytes of str. The checksum starts
+ * at 0xFFFFFFFF and is inverted once all the data is added.
+ */
+static zend_always_inline uint32_t zephir_simd_crc32(uint32_t crc, const char *str, size_t length)
+{
+	return zephir_simd.crc32(crc, (const unsigned char *) str, length);
+}
+
+#endif /* ZEPHIR_KERNEL_SIMD_H */
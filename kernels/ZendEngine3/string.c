@@ -35,6 +35,7 @@
 #include <ext/standard/base64.h>
 #include <ext/standard/md5.h>
 #include <ext/standard/crc32.h>
+#include <main/php_streams.h>
 #include <ext/standard/url.h>
 #include <ext/standard/html.h>
 #include <ext/date/php_date.h>
@@ -52,6 +53,7 @@
 #include "kernel/string.h"
 #include "kernel/operators.h"
 #include "kernel/fcall.h"
+#include "kernel/simd.h"
 
 #define PH_RANDOM_ALNUM 0
 #define PH_RANDOM_ALPHA 1
@@ -96,6 +98,29 @@ int zephir_fast_strlen_ev(zval *str)
 	return length;
 }
 
+/**
+ * Converts the case of a string, returning the same string when it has no
+ * letters to convert
+ */
+static void zephir_string_change_case(zval *return_value, zend_string *str, int upper)
+{
+	zend_string *result;
+	size_t length = ZSTR_LEN(str), prefix;
+
+	prefix = zephir_simd_span_range(ZSTR_VAL(str), length, 0x00, 0x7F, upper ? 'a' : 'A', upper ? 'z' : 'Z');
+	if (prefix == length) {
+		RETVAL_STR_COPY(str);
+		return;
+	}
+
+	result = zend_string_alloc(length, 0);
+	memcpy(ZSTR_VAL(result), ZSTR_VAL(str), prefix);
+	zephir_simd_change_case(ZSTR_VAL(result) + prefix, ZSTR_VAL(str) + prefix, length - prefix, upper);
+	ZSTR_VAL(result)[length] = '\0';
+
+	RETVAL_NEW_STR(result);
+}
+
 /**
  * Fast call to php strtolower
  */
@@ -103,8 +128,6 @@ void zephir_fast_strtolower(zval *return_value, zval *str)
 {
 	zval copy;
 	int use_copy = 0;
-	char *lower_str;
-	unsigned int length;
 
 	if (Z_TYPE_P(str) != IS_STRING) {
 		use_copy = zend_make_printable_zval(str, &copy);
@@ -113,16 +136,11 @@ void zephir_fast_strtolower(zval *return_value, zval *str)
 		}
 	}
 
-	length = Z_STRLEN_P(str);
-	lower_str = estrndup(Z_STRVAL_P(str), length);
-	php_strtolower(lower_str, length);
+	zephir_string_change_case(return_value, Z_STR_P(str), 0);
 
 	if (use_copy) {
 		zval_dtor(str);
 	}
-
-	ZVAL_STRINGL(return_value, lower_str, length);
-	efree(lower_str);
 }
 
 /**
@@ -132,8 +150,6 @@ void zephir_fast_strtoupper(zval *return_value, zval *str)
 {
 	zval copy;
 	int use_copy = 0;
-	char *lower_str;
-	unsigned int length;
 
 	if (Z_TYPE_P(str) != IS_STRING) {
 		use_copy = zend_make_printable_zval(str, &copy);
@@ -142,16 +158,11 @@ void zephir_fast_strtoupper(zval *return_value, zval *str)
 		}
 	}
 
-	length = Z_STRLEN_P(str);
-	lower_str = estrndup(Z_STRVAL_P(str), length);
-	php_strtoupper(lower_str, length);
+	zephir_string_change_case(return_value, Z_STR_P(str), 1);
 
 	if (use_copy) {
 		zval_dtor(str);
 	}
-
-	ZVAL_STRINGL(return_value, lower_str, length);
-	efree(lower_str);
 }
 
 /**
@@ -384,56 +395,80 @@ void zephir_substr(zval *return_value, zval *str, long f, long l, int flags)
 }
 
 /**
- * Appends to a smart_str a printable version of a zval
+ * Receives the bytes of a value printed piece by piece
  */
-static void zephir_append_printable_zval(smart_str *implstr, zval *tmp)
+typedef void (*zephir_printable_sink)(void *context, const char *data, size_t length);
+
+static void zephir_smart_str_sink(void *context, const char *data, size_t length)
 {
-	switch (Z_TYPE_P(tmp)) {
+	smart_str_appendl((smart_str *) context, data, length);
+}
 
-		case IS_STRING:
-			smart_str_appendl(implstr, Z_STRVAL_P(tmp), Z_STRLEN_P(tmp));
-			break;
+static void zephir_md5_sink(void *context, const char *data, size_t length)
+{
+	PHP_MD5Update((PHP_MD5_CTX *) context, data, length);
+}
 
-		default:
-			smart_str_append(implstr, _zval_get_string_func(tmp));
-			break;
-	}
+static void zephir_crc32_sink(void *context, const char *data, size_t length)
+{
+	*(uint32_t *) context = zephir_simd_crc32(*(uint32_t *) context, data, length);
 }
 
-void zephir_append_printable_array(smart_str *implstr, const zval *value)
+static void zephir_print_zval(zephir_printable_sink sink, void *context, zval *value)
 {
+	zend_string *str;
 
-	zval           *tmp;
-	zend_array     *arr;
-	unsigned int numelems, i = 0;
+	if (Z_TYPE_P(value) == IS_STRING) {
+		sink(context, Z_STRVAL_P(value), Z_STRLEN_P(value));
+		return;
+	}
 
-	arr = Z_ARRVAL_P(value);
-	numelems = zend_hash_num_elements(arr);
+	str = zval_get_string(value);
+	sink(context, ZSTR_VAL(str), ZSTR_LEN(str));
+	zend_string_release(str);
+}
 
-	smart_str_appendc(implstr, '[');
+static void zephir_print_array(zephir_printable_sink sink, void *context, const zval *value)
+{
+	zval *tmp;
+	unsigned int numelems = zend_hash_num_elements(Z_ARRVAL_P(value)), i = 0;
 
-	if (numelems > 0) {
+	sink(context, "[", 1);
 
-		ZEND_HASH_FOREACH_VAL(arr, tmp) {
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(value), tmp) {
+		if (Z_TYPE_P(tmp) == IS_ARRAY) {
+			zephir_print_array(sink, context, tmp);
+		} else if (Z_TYPE_P(tmp) != IS_OBJECT) {
+			zephir_print_zval(sink, context, tmp);
+		}
 
-			if (Z_TYPE_P(tmp) == IS_OBJECT) {
+		if (++i != numelems) {
+			sink(context, ",", 1);
+		}
+	} ZEND_HASH_FOREACH_END();
 
-			} else {
-				if (Z_TYPE_P(tmp) == IS_ARRAY) {
-					zephir_append_printable_array(implstr, tmp);
-				} else {
-					zephir_append_printable_zval(implstr, tmp);
-				}
-			}
+	sink(context, "]", 1);
+}
 
-			if (++i != numelems) {
-				smart_str_appendc(implstr, ',');
-			}
+/**
+ * Prints prefix and value as zephir_unique_key() does
+ */
+static void zephir_print_unique_key(zephir_printable_sink sink, void *context, const zval *prefix, zval *value)
+{
+	if (Z_TYPE_P(prefix) == IS_STRING) {
+		sink(context, Z_STRVAL_P(prefix), Z_STRLEN_P(prefix));
+	}
 
-		} ZEND_HASH_FOREACH_END();
+	if (Z_TYPE_P(value) == IS_ARRAY) {
+		zephir_print_array(sink, context, value);
+	} else {
+		zephir_print_zval(sink, context, value);
 	}
+}
 
-	smart_str_appendc(implstr, ']');
+void zephir_append_printable_array(smart_str *implstr, const zval *value)
+{
+	zephir_print_array(zephir_smart_str_sink, implstr, value);
 }
 
 /**
@@ -441,18 +476,9 @@ void zephir_append_printable_array(smart_str *implstr, const zval *value)
  */
 void zephir_unique_key(zval *return_value, const zval *prefix, zval *value)
 {
-
 	smart_str implstr = {0};
 
-	if (Z_TYPE_P(prefix) == IS_STRING) {
-		smart_str_appendl(&implstr, Z_STRVAL_P(prefix), Z_STRLEN_P(prefix));
-	}
-
-	if (Z_TYPE_P(value) == IS_ARRAY) {
-		zephir_append_printable_array(&implstr, value);
-	} else {
-		zephir_append_printable_zval(&implstr, value);
-	}
+	zephir_print_unique_key(zephir_smart_str_sink, &implstr, prefix, value);
 
 	smart_str_0(&implstr);
 
@@ -573,10 +599,10 @@ void zephir_fast_join_str(zval *return_value, char *glue, unsigned int glue_leng
  */
 void zephir_camelize(zval *return_value, const zval *str, const zval *delimiter)
 {
-
-	int i, len, delim_len, pre_del = 1;
-	smart_str camelize_str = {0};
-	char *marker, ch, *delim;
+	size_t i, len, delim_len, span, n = 0;
+	int pre_del = 1;
+	zend_string *camelized;
+	char *marker, *delim, *out;
 
 	if (UNEXPECTED(Z_TYPE_P(str) != IS_STRING)) {
 		zend_error(E_WARNING, "Invalid arguments supplied for camelize()");
@@ -597,28 +623,43 @@ void zephir_camelize(zval *return_value, const zval *str, const zval *delimiter)
 	marker = Z_STRVAL_P(str);
 	len    = Z_STRLEN_P(str);
 
-	for (i = 0; i < len; i++) {
-		ch = marker[i];
+	if (len == 0) {
+		RETURN_EMPTY_STRING();
+	}
+
+	camelized = zend_string_alloc(len, 0);
+	out = ZSTR_VAL(camelized);
 
-		if (memchr(delim, ch, delim_len)) {
+	for (i = 0; i < len; ) {
+		if (memchr(delim, marker[i], delim_len)) {
 			pre_del = 1;
+			i++;
 			continue;
 		}
+
 		if (pre_del == 1) {
-			smart_str_appendc(&camelize_str, toupper(ch));
+			out[n++] = toupper((unsigned char) marker[i]);
 			pre_del = 0;
-		} else {
-			smart_str_appendc(&camelize_str, tolower(ch));
+			i++;
+			continue;
 		}
-	}
 
-	smart_str_0(&camelize_str);
+		/* Lowercase the whole run up to the next delimiter at once */
+		span = zephir_simd_span_not_in(marker + i, len - i, delim, delim_len);
+		zephir_simd_change_case(out + n, marker + i, span, 0);
+		n += span;
+		i += span;
+	}
 
-	if (camelize_str.s) {
-		RETURN_STR(camelize_str.s);
-	} else {
+	if (n == 0) {
+		zend_string_free(camelized);
 		RETURN_EMPTY_STRING();
 	}
+
+	camelized = zend_string_truncate(camelized, n, 0);
+	ZSTR_VAL(camelized)[n] = '\0';
+
+	RETURN_NEW_STR(camelized);
 }
 
 /**
@@ -626,9 +667,9 @@ void zephir_camelize(zval *return_value, const zval *str, const zval *delimiter)
  */
 void zephir_uncamelize(zval *return_value, const zval *str, const zval *delimiter)
 {
-	unsigned int i;
-	smart_str uncamelize_str = {0};
-	char *marker, ch, delim;
+	size_t i, len, span, n = 0;
+	zend_string *uncamelized;
+	char *marker, *out, ch, delim;
 
 	if (Z_TYPE_P(str) != IS_STRING) {
 		zend_error(E_WARNING, "Invalid arguments supplied for uncamelize()");
@@ -645,28 +686,50 @@ void zephir_uncamelize(zval *return_value, const zval *str, const zval *delimite
 	}
 
 	marker = Z_STRVAL_P(str);
-	for (i = 0; i < Z_STRLEN_P(str); i++) {
-		ch = *marker;
+	len    = Z_STRLEN_P(str);
+
+	if (len == 0) {
+		RETURN_EMPTY_STRING();
+	}
+
+	/* Every uppercase letter but the first may add a delimiter */
+	uncamelized = zend_string_safe_alloc(len, 2, 0, 0);
+	out = ZSTR_VAL(uncamelized);
+
+	for (i = 0; i < len; i++) {
+		/* Copy the run of bytes which are neither uppercase letters nor NUL */
+		span = zephir_simd_span_range(marker + i, len - i, 0x01, 0x7F, 'A', 'Z');
+		memcpy(out + n, marker + i, span);
+		n += span;
+		i += span;
+
+		if (i == len) {
+			break;
+		}
+
+		ch = marker[i];
 		if (ch == '\0') {
 			break;
 		}
 		if (ch >= 'A' && ch <= 'Z') {
 			if (i > 0) {
-				smart_str_appendc(&uncamelize_str, delim);
+				out[n++] = delim;
 			}
-			smart_str_appendc(&uncamelize_str, (*marker) + 32);
+			out[n++] = ch + 32;
 		} else {
-			smart_str_appendc(&uncamelize_str, (*marker));
+			out[n++] = ch;
 		}
-		marker++;
 	}
-	smart_str_0(&uncamelize_str);
 
-	if (uncamelize_str.s) {
-		RETURN_STR(uncamelize_str.s);
-	} else {
+	if (n == 0) {
+		zend_string_free(uncamelized);
 		RETURN_EMPTY_STRING();
 	}
+
+	uncamelized = zend_string_truncate(uncamelized, n, 0);
+	ZSTR_VAL(uncamelized)[n] = '\0';
+
+	RETURN_NEW_STR(uncamelized);
 }
 
 /**
@@ -744,6 +807,103 @@ void zephir_fast_explode_str(zval *return_value, const char *delim, int delim_le
 	zend_string_free(delimiter);
 }
 
+/**
+ * Finds needle in [haystack, end), single bytes through memchr
+ */
+static zend_always_inline const char *zephir_memfind(const char *haystack, const char *end, const char *needle, size_t needle_length)
+{
+	if (needle_length == 1) {
+		return (const char *) memchr(haystack, *needle, end - haystack);
+	}
+
+	return php_memnstr(haystack, needle, needle_length, end);
+}
+
+/**
+ * Starts walking the pieces of explode(delimiter, str) without building them
+ * all, see zephir_split_next(). Both arguments must be strings. Returns the
+ * offset of the first piece or -1 if there is nothing to walk.
+ */
+zend_long zephir_split_start(zval *str, zval *delimiter)
+{
+	if (UNEXPECTED(Z_STRLEN_P(delimiter) == 0)) {
+		php_error_docref(NULL, E_WARNING, "Empty delimiter");
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * Assigns to piece the piece of str starting at offset. Returns the offset of
+ * the next piece or -1 after the last one.
+ */
+zend_long zephir_split_next(zval *piece, zval *str, zval *delimiter, zend_long offset)
+{
+	const char *start = Z_STRVAL_P(str) + offset, *end = Z_STRVAL_P(str) + Z_STRLEN_P(str);
+	const char *found = zephir_memfind(start, end, Z_STRVAL_P(delimiter), Z_STRLEN_P(delimiter));
+
+	if (!found) {
+		found = end;
+	}
+
+	if (found == start) {
+		ZVAL_EMPTY_STRING(piece);
+	} else {
+		ZVAL_STRINGL(piece, start, found - start);
+	}
+
+	if (found == end) {
+		return -1;
+	}
+
+	return found - Z_STRVAL_P(str) + Z_STRLEN_P(delimiter);
+}
+
+/**
+ * join(glue, explode(delimiter, str)) without the pieces: the delimiters are
+ * counted first, so the result is allocated once at its final size
+ */
+void zephir_fast_join_split(zval *return_value, zval *glue, zval *delimiter, zval *str)
+{
+	zend_string *g = zval_get_string(glue), *d = zval_get_string(delimiter), *s = zval_get_string(str), *result;
+	const char *p, *found, *end = ZSTR_VAL(s) + ZSTR_LEN(s);
+	size_t count = 0;
+	char *out;
+
+	if (UNEXPECTED(ZSTR_LEN(d) == 0)) {
+		php_error_docref(NULL, E_WARNING, "Empty delimiter");
+		RETVAL_EMPTY_STRING();
+	} else {
+		for (p = ZSTR_VAL(s); (found = zephir_memfind(p, end, ZSTR_VAL(d), ZSTR_LEN(d))); p = found + ZSTR_LEN(d)) {
+			count++;
+		}
+
+		if (count == 0 || zend_string_equals(g, d)) {
+			RETVAL_STR_COPY(s);
+		} else {
+			result = zend_string_alloc(ZSTR_LEN(s) - count * ZSTR_LEN(d) + count * ZSTR_LEN(g), 0);
+			out = ZSTR_VAL(result);
+
+			for (p = ZSTR_VAL(s); (found = zephir_memfind(p, end, ZSTR_VAL(d), ZSTR_LEN(d))); p = found + ZSTR_LEN(d)) {
+				memcpy(out, p, found - p);
+				out += found - p;
+				memcpy(out, ZSTR_VAL(g), ZSTR_LEN(g));
+				out += ZSTR_LEN(g);
+			}
+
+			memcpy(out, p, end - p);
+			out[end - p] = '\0';
+
+			RETVAL_NEW_STR(result);
+		}
+	}
+
+	zend_string_release(g);
+	zend_string_release(d);
+	zend_string_release(s);
+}
+
 /**
  * Immediate function resolution for strpos function
  */
@@ -1044,18 +1204,13 @@ void zephir_fast_str_replace(zval *return_value_ptr, zval *search, zval *replace
 #ifdef ZEPHIR_USE_PHP_PCRE
 
 /**
- * Execute preg-match without function lookup in the PHP userland
+ * Matches a subject with a compiled regex. The matches array is only built
+ * when the caller asked for it.
  */
-void zephir_preg_match(zval *return_value, zval *regex, zval *subject, zval *matches, int global, long flags, long offset)
+static void zephir_preg_match_pce(zval *return_value, pcre_cache_entry *pce, zval *subject, zval *matches, int global, long flags, long offset)
 {
 	int use_copy = 0;
 	zval copy, tmp_matches;
-	pcre_cache_entry *pce;
-
-	if (Z_TYPE_P(regex) != IS_STRING) {
-		zend_error(E_WARNING, "Invalid arguments supplied for zephir_preg_match()");
-		RETURN_FALSE;
-	}
 
 	if (Z_TYPE_P(subject) != IS_STRING) {
 		use_copy = zend_make_printable_zval(subject, &copy);
@@ -1064,14 +1219,14 @@ void zephir_preg_match(zval *return_value, zval *regex, zval *subject, zval *mat
 		}
 	}
 
-	/* Compile regex or get it from cache */
-	if ((pce = pcre_get_compiled_regex_cache(Z_STR_P(regex))) == NULL) {
+	if (!matches) {
+		php_pcre_match_impl(pce, Z_STRVAL_P(subject), Z_STRLEN_P(subject), return_value, NULL, global, flags != 0 || offset != 0, flags, offset);
 
 		if (use_copy) {
-			zval_dtor(subject);
+			zval_dtor(&copy);
 		}
 
-		RETURN_FALSE;
+		return;
 	}
 
 	ZVAL_UNDEF(&tmp_matches);
@@ -1082,7 +1237,7 @@ void zephir_preg_match(zval *return_value, zval *regex, zval *subject, zval *mat
 		php_pcre_match_impl(pce, Z_STRVAL_P(subject), Z_STRLEN_P(subject), return_value, &tmp_matches, global, 0, 0, 0);
 	}
 
-	if (matches) {
+	{
 		zval *php_matches = &tmp_matches;
 
 		zval_dtor(matches);
@@ -1097,6 +1252,70 @@ void zephir_preg_match(zval *return_value, zval *regex, zval *subject, zval *mat
 	}
 }
 
+/**
+ * Execute preg-match without function lookup in the PHP userland
+ */
+void zephir_preg_match(zval *return_value, zval *regex, zval *subject, zval *matches, int global, long flags, long offset)
+{
+	pcre_cache_entry *pce;
+
+	if (Z_TYPE_P(regex) != IS_STRING) {
+		zend_error(E_WARNING, "Invalid arguments supplied for zephir_preg_match()");
+		RETURN_FALSE;
+	}
+
+	/* Compile regex or get it from cache */
+	if ((pce = pcre_get_compiled_regex_cache(Z_STR_P(regex))) == NULL) {
+		RETURN_FALSE;
+	}
+
+	zephir_preg_match_pce(return_value, pce, subject, matches, global, flags, offset);
+}
+
+#ifndef ZTS
+/**
+ * Execute preg-match with a literal regex, compiled on the first call of the
+ * call site and kept in its cache afterwards
+ */
+void zephir_preg_match_cached(zval *return_value, pcre_cache_entry **cache, const char *regex, size_t regex_length, zval *subject, zval *matches, int global, long flags, long offset)
+{
+	pcre_cache_entry *pce = *cache;
+
+#ifdef HAVE_SETLOCALE
+	/* The regex of the call site was compiled for the "C" locale, the PCRE cache has one per locale */
+	if (UNEXPECTED(BG(locale_string) && (ZSTR_LEN(BG(locale_string)) != 1 || ZSTR_VAL(BG(locale_string))[0] != 'C'))) {
+		zval pattern;
+
+		ZVAL_STRINGL(&pattern, regex, regex_length);
+		zephir_preg_match(return_value, &pattern, subject, matches, global, flags, offset);
+		zval_ptr_dtor(&pattern);
+		return;
+	}
+#endif
+
+	if (UNEXPECTED(pce == NULL)) {
+		zend_string *pattern = zend_string_init(regex, regex_length, 0);
+
+		pce = pcre_get_compiled_regex_cache(pattern);
+		zend_string_release(pattern);
+
+		if (pce == NULL) {
+			RETURN_FALSE;
+		}
+
+		/* Referenced entries are never evicted from the PCRE cache */
+#if PHP_VERSION_ID >= 70300
+		php_pcre_pce_incref(pce);
+#else
+		pce->refcount++;
+#endif
+		*cache = pce;
+	}
+
+	zephir_preg_match_pce(return_value, pce, subject, matches, global, flags, offset);
+}
+#endif
+
 #else
 
 void zephir_preg_match(zval *return_value, zval *regex, zval *subject, zval *matches, int global, long flags, long offset)
@@ -1208,56 +1427,170 @@ int zephir_json_decode(zval *return_value, zval *v, zend_bool assoc)
 
 #endif /* ZEPHIR_USE_PHP_JSON */
 
-void zephir_md5(zval *return_value, zval *str)
+static void zephir_md5_result(zval *return_value, PHP_MD5_CTX *ctx)
 {
-	PHP_MD5_CTX ctx;
 	unsigned char digest[16];
 	char hexdigest[33];
-	zval copy;
-	int use_copy = 0;
 
-	if (Z_TYPE_P(str) != IS_STRING) {
-		use_copy = zend_make_printable_zval(str, &copy);
-		if (use_copy) {
-			str = &copy;
-		}
+	PHP_MD5Final(digest, ctx);
+	make_digest(hexdigest, digest);
+
+	RETVAL_STRINGL(hexdigest, 32);
+}
+
+/**
+ * Feeds a stream to sink until its end, in chunks. FAILURE if a read fails
+ */
+static int zephir_print_stream(zephir_printable_sink sink, void *context, php_stream *stream)
+{
+	char buf[8192];
+	ssize_t n;
+
+	while ((n = php_stream_read(stream, buf, sizeof(buf))) > 0) {
+		sink(context, buf, n);
+	}
+
+	return n < 0 ? FAILURE : SUCCESS;
+}
+
+static php_stream *zephir_hash_fetch_stream(zval *stream_zval)
+{
+	php_stream *stream;
+
+	if (Z_TYPE_P(stream_zval) != IS_RESOURCE) {
+		php_error_docref(NULL, E_WARNING, "Invalid arguments supplied, a stream is expected");
+		return NULL;
+	}
+
+	php_stream_from_zval_no_verify(stream, stream_zval);
+
+	return stream;
+}
+
+/**
+ * Opens a file as file_get_contents() does, NULL on failure
+ */
+static php_stream *zephir_hash_open_file(zval *filename)
+{
+	if (Z_TYPE_P(filename) != IS_STRING) {
+		php_error_docref(NULL, E_WARNING, "Invalid arguments supplied for file_get_contents()");
+		return NULL;
+	}
+
+	return php_stream_open_wrapper_ex(Z_STRVAL_P(filename), "rb", REPORT_ERRORS, NULL, php_stream_context_from_zval(NULL, 0));
+}
+
+void zephir_md5(zval *return_value, zval *str)
+{
+	PHP_MD5_CTX ctx;
+
+	PHP_MD5Init(&ctx);
+	zephir_print_zval(zephir_md5_sink, &ctx, str);
+	zephir_md5_result(return_value, &ctx);
+}
+
+/**
+ * md5(zephir_unique_key(prefix, value)) without building the key
+ */
+void zephir_md5_unique_key(zval *return_value, const zval *prefix, zval *value)
+{
+	PHP_MD5_CTX ctx;
+
+	PHP_MD5Init(&ctx);
+	zephir_print_unique_key(zephir_md5_sink, &ctx, prefix, value);
+	zephir_md5_result(return_value, &ctx);
+}
+
+/**
+ * md5() of the rest of a stream, read in chunks, false if it cannot be read
+ */
+void zephir_md5_stream(zval *return_value, zval *stream_zval)
+{
+	PHP_MD5_CTX ctx;
+	php_stream *stream = zephir_hash_fetch_stream(stream_zval);
+
+	if (!stream) {
+		RETURN_FALSE;
 	}
 
 	PHP_MD5Init(&ctx);
-	PHP_MD5Update(&ctx, Z_STRVAL_P(str), Z_STRLEN_P(str));
-	PHP_MD5Final(digest, &ctx);
+	if (zephir_print_stream(zephir_md5_sink, &ctx, stream) == FAILURE) {
+		RETURN_FALSE;
+	}
 
-	make_digest(hexdigest, digest);
+	zephir_md5_result(return_value, &ctx);
+}
+
+/**
+ * md5(file_get_contents(filename)) reading the file in chunks. As
+ * file_get_contents() does, a failed read keeps the bytes read so far
+ */
+void zephir_md5_file(zval *return_value, zval *filename)
+{
+	PHP_MD5_CTX ctx;
+	php_stream *stream = zephir_hash_open_file(filename);
 
-	ZVAL_STRINGL(return_value, hexdigest, 32);
+	PHP_MD5Init(&ctx);
+	if (stream) {
+		zephir_print_stream(zephir_md5_sink, &ctx, stream);
+		php_stream_close(stream);
+	}
+
+	zephir_md5_result(return_value, &ctx);
 }
 
 void zephir_crc32(zval *return_value, zval *str)
 {
-	zval copy;
-	int use_copy = 0;
-	size_t nr;
-	char *p;
-	php_uint32 crc;
-	php_uint32 crcinit = 0;
+	uint32_t crc = 0xFFFFFFFF;
 
-	if (Z_TYPE_P(str) != IS_STRING) {
-		use_copy = zend_make_printable_zval(str, &copy);
-		if (use_copy) {
-			str = &copy;
-		}
-	}
+	zephir_print_zval(zephir_crc32_sink, &crc, str);
+
+	RETVAL_LONG(crc ^ 0xFFFFFFFF);
+}
+
+/**
+ * crc32(zephir_unique_key(prefix, value)) without building the key
+ */
+void zephir_crc32_unique_key(zval *return_value, const zval *prefix, zval *value)
+{
+	uint32_t crc = 0xFFFFFFFF;
+
+	zephir_print_unique_key(zephir_crc32_sink, &crc, prefix, value);
+
+	RETVAL_LONG(crc ^ 0xFFFFFFFF);
+}
+
+/**
+ * crc32() of the rest of a stream, read in chunks, false if it cannot be read
+ */
+void zephir_crc32_stream(zval *return_value, zval *stream_zval)
+{
+	uint32_t crc = 0xFFFFFFFF;
+	php_stream *stream = zephir_hash_fetch_stream(stream_zval);
 
-	p = Z_STRVAL_P(str);
-	nr = Z_STRLEN_P(str);
+	if (!stream) {
+		RETURN_FALSE;
+	}
 
-	crc = crcinit^0xFFFFFFFF;
-	for (; nr--; ++p) {
-		crc = ((crc >> 8) & 0x00FFFFFF) ^ crc32tab[(crc ^ (*p)) & 0xFF];
+	if (zephir_print_stream(zephir_crc32_sink, &crc, stream) == FAILURE) {
+		RETURN_FALSE;
 	}
 
-	if (use_copy) {
-		zval_dtor(str);
+	RETVAL_LONG(crc ^ 0xFFFFFFFF);
+}
+
+/**
+ * crc32(file_get_contents(filename)) reading the file in chunks, keeping
+ * the bytes read before a failed read
+ */
+void zephir_crc32_file(zval *return_value, zval *filename)
+{
+	uint32_t crc = 0xFFFFFFFF;
+	php_stream *stream = zephir_hash_open_file(filename);
+
+	if (stream) {
+		zephir_print_stream(zephir_crc32_sink, &crc, stream);
+		php_stream_close(stream);
 	}
 
 	RETVAL_LONG(crc ^ 0xFFFFFFFF);
@@ -1359,10 +1692,6 @@ void zephir_stripcslashes(zval *return_value, zval *str)
  */
 int zephir_hash_equals(const zval *known_zval, const zval *user_zval)
 {
-	char *known_str, *user_str;
-	int result = 0;
-	size_t j;
-
 	if (Z_TYPE_P(known_zval) != IS_STRING || Z_TYPE_P(user_zval) != IS_STRING) {
 		return 0;
 	}
@@ -1371,14 +1700,7 @@ int zephir_hash_equals(const zval *known_zval, const zval *user_zval)
 		return 0;
 	}
 
-	known_str = Z_STRVAL_P(known_zval);
-	user_str = Z_STRVAL_P(user_zval);
-
-	for (j = 0; j < Z_STRLEN_P(known_zval); j++) {
-		result |= known_str[j] ^ user_str[j];
-	}
-
-	return (int) (result == 0);
+	return !zephir_simd_diff(Z_STRVAL_P(known_zval), Z_STRVAL_P(user_zval), Z_STRLEN_P(known_zval));
 }
 
 void zephir_string_to_hex(zval *return_value, zval *var)
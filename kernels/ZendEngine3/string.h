@@ -42,6 +42,9 @@ void zephir_fast_join(zval *result, zval *glue, zval *pieces);
 void zephir_fast_join_str(zval *result, char *glue, unsigned int glue_length, zval *pieces);
 void zephir_fast_explode(zval *result, zval *delimiter, zval *str, long limit);
 void zephir_fast_explode_str(zval *result, const char *delimiter, int delimiter_length, zval *str, long limit);
+zend_long zephir_split_start(zval *str, zval *delimiter);
+zend_long zephir_split_next(zval *piece, zval *str, zval *delimiter, zend_long offset);
+void zephir_fast_join_split(zval *result, zval *glue, zval *delimiter, zval *str);
 void zephir_fast_strpos(zval *return_value, const zval *haystack, const zval *needle, unsigned int offset);
 void zephir_fast_strpos_str(zval *return_value, const zval *haystack, char *needle, unsigned int needle_length);
 void zephir_fast_trim(zval *return_value, zval *str, zval *charlist, int where);
@@ -71,10 +74,43 @@ void zephir_substr(zval *return_value, zval *str, long from, long length, int fl
 /** Preg-Match */
 void zephir_preg_match(zval *return_value, zval *regex, zval *subject, zval *matches, int global, long flags, long offset);
 
+/*
+ * Preg-Match with a literal regex. The compiled regex of each call site is
+ * cached in a static variable, so it is only used in non-ZTS builds. It is
+ * compiled for the "C" locale, other locales go through zephir_preg_match().
+ */
+#if defined(ZEPHIR_USE_PHP_PCRE) && !defined(ZTS)
+#include <ext/pcre/php_pcre.h>
+
+void zephir_preg_match_cached(zval *return_value, pcre_cache_entry **cache, const char *regex, size_t regex_length, zval *subject, zval *matches, int global, long flags, long offset);
+
+#define zephir_preg_match_literal(return_value, regex, subject, matches, global, flags, offset) \
+	do { \
+		static pcre_cache_entry *zephir_pcre_cache_ = NULL; \
+		zephir_preg_match_cached(return_value, &zephir_pcre_cache_, regex, sizeof(regex) - 1, subject, matches, global, flags, offset); \
+	} while (0)
+#else
+#define zephir_preg_match_literal(return_value, regex, subject, matches, global, flags, offset) \
+	do { \
+		zval zephir_regex_; \
+		ZVAL_STRINGL(&zephir_regex_, regex, sizeof(regex) - 1); \
+		zephir_preg_match(return_value, &zephir_regex_, subject, matches, global, flags, offset); \
+		zval_ptr_dtor(&zephir_regex_); \
+	} while (0)
+#endif
+
 /** Hash */
 void zephir_md5(zval *return_value, zval *str);
 void zephir_crc32(zval *return_value, zval *str);
 
+/* Hashes computed in chunks, without building the whole data in memory */
+void zephir_md5_unique_key(zval *return_value, const zval *prefix, zval *value);
+void zephir_md5_stream(zval *return_value, zval *stream);
+void zephir_md5_file(zval *return_value, zval *filename);
+void zephir_crc32_unique_key(zval *return_value, const zval *prefix, zval *value);
+void zephir_crc32_stream(zval *return_value, zval *stream);
+void zephir_crc32_file(zval *return_value, zval *filename);
+
 /** */
 void zephir_ucfirst(zval *return_value, zval *s);
 void zephir_addslashes(zval *return_value, zval *str);
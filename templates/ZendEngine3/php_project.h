@@ -28,6 +28,9 @@ ZEND_BEGIN_MODULE_GLOBALS(%PROJECT_LOWER%)
 
 	zephir_fcall_cache_entry *scache[ZEPHIR_MAX_CACHE_SLOTS];
 
+	/** Memory frames */
+	zephir_frame_arena frame_arena;
+
 	/* Cache enabled */
 	unsigned int cache_enabled;
 
@@ -20,6 +20,7 @@
 #include "kernel/main.h"
 #include "kernel/fcall.h"
 #include "kernel/memory.h"
+#include "kernel/simd.h"
 
 %EXTRA_INCLUDES%
 
@@ -66,6 +67,9 @@ static void php_zephir_init_globals(zend_%PROJECT_LOWER%_globals *%PROJECT_LOWER
 	/* Static cache */
 	memset(%PROJECT_LOWER%_globals->scache, '\0', sizeof(zephir_fcall_cache_entry*) * ZEPHIR_MAX_CACHE_SLOTS);
 
+	/* Memory frames */
+	memset(&%PROJECT_LOWER%_globals->frame_arena, '\0', sizeof(zephir_frame_arena));
+
 	%INIT_GLOBALS%
 }
 
@@ -113,6 +117,7 @@ static PHP_MINFO_FUNCTION(%PROJECT_LOWER%)
 	php_info_print_table_row(2, "Version", PHP_%PROJECT_UPPER%_VERSION);
 	php_info_print_table_row(2, "Build Date", __DATE__ " " __TIME__ );
 	php_info_print_table_row(2, "Powered by Zephir", "Version " PHP_%PROJECT_UPPER%_ZEPVERSION);
+	php_info_print_table_row(2, "String kernels", zephir_simd_name());
 	php_info_print_table_end();
 	%EXTENSION_INFO%
 	DISPLAY_INI_ENTRIES();
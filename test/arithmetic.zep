@@ -1464,4 +1464,14 @@ class Arithmetic
 	{
 		return (this->tmp1 - 1) / 4;
 	}
+
+	public function mulVars(var a, var b)
+	{
+		return a * b;
+	}
+
+	public function subVars(var a, var b)
+	{
+		return a - b;
+	}
 }
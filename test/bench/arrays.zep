@@ -0,0 +1,63 @@
+namespace Test\Bench;
+
+/**
+ * Workloads dominated by packed arrays.
+ *
+ * Build the extension before and after a kernel change and compare the
+ * timings of e.g. Test\Bench\Arrays::fannkuch(9, 10).
+ */
+class Arrays
+{
+	/**
+	 * Indexed fetch/update of small packed arrays
+	 */
+	public static function fannkuch(int n, int iterations = 1) -> array
+	{
+		var fannkuch, result;
+		int i;
+
+		let fannkuch = new \Test\Fannkuch();
+		for i in range(1, iterations) {
+			let result = fannkuch->process(n);
+		}
+
+		return result;
+	}
+
+	/**
+	 * Packed arrays of strings, the output is discarded
+	 */
+	public static function fasta(int n, int iterations = 1)
+	{
+		var fasta;
+		int i;
+
+		let fasta = new \Test\Fasta();
+		for i in range(1, iterations) {
+			ob_start();
+			fasta->main(n);
+			ob_end_clean();
+		}
+	}
+
+	/**
+	 * Foreach and indexed access over a packed array of n elements
+	 */
+	public static function packed(int n, int iterations = 1) -> int
+	{
+		var items, item;
+		int i, j, sum = 0;
+
+		let items = range(0, n - 1);
+		for i in range(1, iterations) {
+			for item in items {
+				let sum += item;
+			}
+			for j in range(0, n - 1) {
+				let sum -= items[j];
+			}
+		}
+
+		return sum;
+	}
+}
@@ -0,0 +1,79 @@
+namespace Test\Bench;
+
+/**
+ * Call throughput of methods that grow/restore a memory frame.
+ *
+ * Build the extension before and after a kernel change and compare the
+ * timings of e.g. Test\Bench\Calls::frames(1000000).
+ */
+class Calls
+{
+	public static function frame(var a)
+	{
+		var b;
+
+		let b = [a];
+		return b;
+	}
+
+	public static function deep(int depth)
+	{
+		var b;
+
+		let b = [depth];
+		if depth > 0 {
+			return self::deep(depth - 1);
+		}
+
+		return b;
+	}
+
+	public static function manyLocals(var a)
+	{
+		var b0, b1, b2, b3, b4, b5, b6, b7, b8, b9, b10, b11, b12, b13, b14,
+			b15, b16, b17, b18, b19, b20, b21, b22, b23, b24, b25, b26, b27;
+
+		let b0 = [a], b1 = [a], b2 = [a], b3 = [a], b4 = [a], b5 = [a], b6 = [a],
+			b7 = [a], b8 = [a], b9 = [a], b10 = [a], b11 = [a], b12 = [a], b13 = [a],
+			b14 = [a], b15 = [a], b16 = [a], b17 = [a], b18 = [a], b19 = [a], b20 = [a],
+			b21 = [a], b22 = [a], b23 = [a], b24 = [a], b25 = [a], b26 = [a], b27 = [a];
+
+		return b27;
+	}
+
+	/**
+	 * One frame per call
+	 */
+	public static function frames(var n)
+	{
+		var i;
+
+		for i in range(1, n) {
+			self::frame(i);
+		}
+	}
+
+	/**
+	 * Nested frames crossing several arena chunks
+	 */
+	public static function nestedFrames(var n, int depth = 64)
+	{
+		var i;
+
+		for i in range(1, n) {
+			self::deep(depth);
+		}
+	}
+
+	/**
+	 * Frames observing more variables than the preallocated slots
+	 */
+	public static function largeFrames(var n)
+	{
+		var i;
+
+		for i in range(1, n) {
+			self::manyLocals(i);
+		}
+	}
+}
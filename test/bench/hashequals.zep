@@ -0,0 +1,47 @@
+namespace Test\Bench;
+
+/**
+ * hash_equals() over tokens of increasing size.
+ *
+ * Build the extension before and after a kernel change and compare the
+ * timings of e.g. Test\Bench\HashEquals::run(100000). The timings of the
+ * three cases of a size should be the same: only the length may show.
+ */
+class HashEquals
+{
+	/**
+	 * Times equal tokens and tokens differing in the first or the last byte
+	 */
+	public static function run(var n, array sizes = [16, 64, 256, 4096]) -> array
+	{
+		var size, known, timings, start;
+
+		let timings = [];
+		for size in sizes {
+			let known = str_repeat("a", size);
+
+			let start = microtime(true);
+			self::compare(known, str_repeat("a", size), n);
+			let timings[size]["equal"] = microtime(true) - start;
+
+			let start = microtime(true);
+			self::compare(known, "b" . str_repeat("a", size - 1), n);
+			let timings[size]["first"] = microtime(true) - start;
+
+			let start = microtime(true);
+			self::compare(known, str_repeat("a", size - 1) . "b", n);
+			let timings[size]["last"] = microtime(true) - start;
+		}
+
+		return timings;
+	}
+
+	public static function compare(string known, string user, var n)
+	{
+		var i, equal;
+
+		for i in range(1, n) {
+			let equal = hash_equals(known, user);
+		}
+	}
+}
@@ -0,0 +1,116 @@
+namespace Test\Bench;
+
+/**
+ * String kernels over inputs of increasing size.
+ *
+ * Build the extension before and after a kernel change and compare the
+ * timings of e.g. Test\Bench\Strings::run(100000), which returns the
+ * seconds spent by each function for every input size.
+ */
+class Strings
+{
+	/**
+	 * Times every kernel for each size
+	 */
+	public static function run(var n, array sizes = [8, 32, 256, 4096]) -> array
+	{
+		var size, input, camelized, timings, start;
+
+		let timings = [];
+		for size in sizes {
+			let input = self::input(size),
+				camelized = camelize(input);
+
+			let start = microtime(true);
+			self::lower(input, n);
+			let timings[size]["strtolower"] = microtime(true) - start;
+
+			let start = microtime(true);
+			self::upper(input, n);
+			let timings[size]["strtoupper"] = microtime(true) - start;
+
+			let start = microtime(true);
+			self::camelize(input, n);
+			let timings[size]["camelize"] = microtime(true) - start;
+
+			let start = microtime(true);
+			self::uncamelize(camelized, n);
+			let timings[size]["uncamelize"] = microtime(true) - start;
+
+			let start = microtime(true);
+			self::split(input, n);
+			let timings[size]["explode"] = microtime(true) - start;
+
+			let start = microtime(true);
+			self::joinSplit(input, n);
+			let timings[size]["join(explode)"] = microtime(true) - start;
+		}
+
+		return timings;
+	}
+
+	/**
+	 * Mostly lowercase words joined by underscores, like identifiers and headers
+	 */
+	public static function input(int size) -> string
+	{
+		return substr(str_repeat("content_Type_x_forwarded_for_", size / 29 + 1), 0, size);
+	}
+
+	public static function lower(string input, var n)
+	{
+		var i, s;
+
+		for i in range(1, n) {
+			let s = strtolower(input);
+		}
+	}
+
+	public static function upper(string input, var n)
+	{
+		var i, s;
+
+		for i in range(1, n) {
+			let s = strtoupper(input);
+		}
+	}
+
+	public static function camelize(string input, var n)
+	{
+		var i, s;
+
+		for i in range(1, n) {
+			let s = camelize(input);
+		}
+	}
+
+	public static function uncamelize(string input, var n)
+	{
+		var i, s;
+
+		for i in range(1, n) {
+			let s = uncamelize(input);
+		}
+	}
+
+	public static function split(string input, var n)
+	{
+		var i, part, length;
+
+		for i in range(1, n) {
+			let length = 0;
+			for part in explode("_", input) {
+				let length += strlen(part);
+			}
+		}
+	}
+
+	public static function joinSplit(string input, var n)
+	{
+		var i, s;
+
+		for i in range(1, n) {
+			let s = join("-", explode("_", input));
+		}
+	}
+}
@@ -89,4 +89,50 @@ class Compare
 
 		return 0 != a;
 	}
-}
\ No newline at end of file
+
+	public function testVarNumberCompare(var a) -> array
+	{
+		return [
+			a < 2.5,
+			a > 2.5,
+			a <= 2,
+			a >= 2,
+			a == 2.5,
+			a != 2.5,
+			a === 2.0,
+			a !== 2.0,
+			2.5 < a,
+			2.5 == a
+		];
+	}
+
+	public function testVarVarCompare(var a, var b) -> array
+	{
+		return [a < b, a <= b, a > b, a >= b, a == b, a != b];
+	}
+
+	public function testDoubleVarCompare(int n) -> int
+	{
+		var score;
+		int i, above = 0;
+
+		let score = 0.0;
+		for i in range(1, n) {
+			let score = i / 2;
+			if score > 5 {
+				let above++;
+			}
+		}
+
+		return above;
+	}
+
+	public function testCountInference(array items)
+	{
+		var n;
+
+		let n = count(items);
+
+		return n + 1;
+	}
+}
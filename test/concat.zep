@@ -44,4 +44,24 @@ class Concat
 		let b .= a;
 		return b;
 	}
+
+	public function testConcat4(int id, double price, char separator) -> string
+	{
+		return "id=" . id . separator . "price=" . price . separator . "qty=" . 10 . ";";
+	}
+
+	public function testConcatDouble(double number) -> string
+	{
+		return "[" . number . "]";
+	}
+
+	public function testConcatUnsigned(ulong number) -> string
+	{
+		return "[" . number . "]";
+	}
+
+	public function testConcatLong(long number) -> string
+	{
+		return "[" . number . "]";
+	}
 }
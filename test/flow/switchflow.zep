@@ -161,4 +161,103 @@ class SwitchFlow
                 return 0;
         }
     }
+
+    public function testSwitchInt(int a) -> int
+    {
+        int b = 0;
+
+        switch a {
+            case 1:
+            case 2:
+                let b = 12;
+            case 3:
+                let b += 3;
+            case -4:
+                return -4;
+            case 100:
+                return 100;
+        }
+
+        return b;
+    }
+
+    public function testSwitchChar(char c) -> string
+    {
+        switch c {
+            case 'a':
+            case 'e':
+            case 'i':
+            case 'o':
+            case 'u':
+                return "vowel";
+            case ' ':
+            case '\n':
+                return "space";
+            default:
+                return "other";
+        }
+    }
+
+    public function testSwitchLongLabels(var a) -> int
+    {
+        switch a {
+            case 0:
+                return 10;
+            case 1:
+                return 11;
+            case 2:
+            case 3:
+                return 12;
+            case 40:
+                return 13;
+            default:
+                return -1;
+        }
+    }
+
+    public function testSwitchStringLabels(var verb) -> int
+    {
+        switch verb {
+            case "GET":
+                return 1;
+            case "PUT":
+                return 2;
+            case "POST":
+            case "PATCH":
+                return 3;
+            case "HEAD":
+                return 4;
+            case "DELETE":
+                return 5;
+            case "":
+                return 6;
+            case "1":
+                return 7;
+            case "a\"b":
+                return 8;
+            default:
+                return 0;
+        }
+    }
+
+    public function testSwitchStringLoop(array verbs) -> int
+    {
+        var verb;
+        int count = 0;
+
+        for verb in verbs {
+            switch verb {
+                case "GET":
+                case "HEAD":
+                    let count += 1;
+                    break;
+                case "PUT":
+                case "POST":
+                    let count += 10;
+                    break;
+            }
+        }
+
+        return count;
+    }
 }
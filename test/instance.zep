@@ -49,4 +49,29 @@ class Instance
 	{
 		return create_instance(className);
 	}
+
+	public static function testCreateInstances(array classNames) -> array
+	{
+		var className, instances;
+
+		let instances = [];
+		for className in classNames {
+			let instances[] = create_instance(className);
+		}
+
+		return instances;
+	}
+
+	public static function testCreateInstancesParams(string className, array parameters, int times) -> array
+	{
+		var instances;
+		int i;
+
+		let instances = [];
+		for i in range(1, times) {
+			let instances[] = create_instance_params(className, parameters);
+		}
+
+		return instances;
+	}
 }
@@ -262,4 +262,15 @@ class Mcall
 		let a = new self;
 		return a->bb();
 	}
+
+	public function callPolymorphic(array objects) -> array
+	{
+		var obj, names = [];
+
+		for obj in objects {
+			let names[] = obj->getName();
+		}
+
+		return names;
+	}
 }
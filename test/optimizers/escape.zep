@@ -0,0 +1,25 @@
+
+namespace Test\Optimizers;
+
+class Escape
+{
+	public static function css(var value)
+	{
+		return escape_css(value);
+	}
+
+	public static function js(var value)
+	{
+		return escape_js(value);
+	}
+
+	public static function cssUtf8(var value)
+	{
+		return escape_css_utf8(value);
+	}
+
+	public static function jsUtf8(var value)
+	{
+		return escape_js_utf8(value);
+	}
+}
@@ -0,0 +1,58 @@
+
+namespace Test\Optimizers;
+
+class InArray
+{
+	static public function find(var needle, array haystack)
+	{
+		return in_array(needle, haystack);
+	}
+
+	static public function findStrict(var needle, array haystack)
+	{
+		return in_array(needle, haystack, true);
+	}
+
+	static public function filter(array needles, array haystack) -> array
+	{
+		var needle, found = [];
+
+		for needle in needles {
+			if in_array(needle, haystack) {
+				let found[] = needle;
+			}
+		}
+
+		return found;
+	}
+
+	static public function filterStrict(array needles, array haystack) -> array
+	{
+		var needle, found = [];
+
+		for needle in needles {
+			if in_array(needle, haystack, true) {
+				let found[] = needle;
+			}
+		}
+
+		return found;
+	}
+
+	/**
+	 * The haystack changes between lookups without an assignment in the loop
+	 */
+	static public function filterShrinking(array needles, array haystack) -> array
+	{
+		var needle, found = [];
+
+		for needle in needles {
+			if in_array(needle, haystack) {
+				let found[] = needle;
+			}
+			array_shift(haystack);
+		}
+
+		return found;
+	}
+}
@@ -114,4 +114,35 @@ class Pregmatch
 
 		return [m1, m2];
 	}
+
+	public function testLiteralPattern(string subject)
+	{
+		return preg_match("/^[a-z]+[0-9]+$/", subject);
+	}
+
+	public function testLiteralAlphaPattern(string subject)
+	{
+		return preg_match("/^[[:alpha:]]+$/", subject);
+	}
+
+	public function testLiteralPatternMatches(string subject)
+	{
+		var matches = null;
+		preg_match("/([a-z]+)([0-9]+)/", subject, matches);
+
+		return matches;
+	}
+
+	public function testLiteralPatternInLoop(array subjects)
+	{
+		var subject, matched = 0;
+
+		for subject in subjects {
+			if preg_match("/^[a-z]+[0-9]+$/", subject) {
+				let matched++;
+			}
+		}
+
+		return matched;
+	}
 }
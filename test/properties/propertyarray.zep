@@ -21,6 +21,11 @@ class PropertyArray
 	 */
 	protected otherArray = [];
 
+	/**
+	 * This is a public property with an initial constant map value
+	 */
+	public someMap = ["one": 1, "two": [2.5, true, null, "two"], 3: "three"];
+
 	public function __construct()
 	{
 		let this->someArray = [1];
@@ -31,6 +36,11 @@ class PropertyArray
 		let this->someArray[] = (string) value;
 	}
 
+	public function setSomeMapItem(var key, var value)
+	{
+		let this->someMap[key] = value;
+	}
+
 	public function setOtherArray(arr){
 		let this->otherArray = arr;
 	}
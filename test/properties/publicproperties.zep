@@ -77,4 +77,15 @@ class PublicProperties
     {
 		return this->{"someTrue"};
     }
+
+	public function swapSomeIntegerAndString()
+	{
+		var tmp;
+
+		let tmp = this->someInteger;
+		let this->someInteger = this->someString;
+		let this->someString = tmp;
+
+		return [this->someInteger, this->someString];
+	}
 }
@@ -16,4 +16,53 @@ class StaticPropertyArray
 	 * This is a public property with an initial array value
 	 */
 	public static someArray = [1, 2, 3, 4];
+
+	public static defaults = ["a": 1, "b": 2];
+
+	protected static registry = [];
+
+	protected static lazy;
+
+	public static function register(var key, var value) -> void
+	{
+		let self::registry[key] = value;
+	}
+
+	public static function registerNested(var key, var subKey, var value) -> void
+	{
+		let self::registry[key][subKey] = value;
+	}
+
+	public static function registerLazy(var key, var value) -> array
+	{
+		let self::lazy[key] = value;
+
+		return self::lazy;
+	}
+
+	public static function setDefault(var key, var value) -> void
+	{
+		let self::defaults[key] = value;
+	}
+
+	public static function fill(int n) -> int
+	{
+		int i;
+
+		for i in range(1, n) {
+			let self::registry["item" . i] = i;
+		}
+
+		return count(self::registry);
+	}
+
+	public static function getRegistry() -> array
+	{
+		return self::registry;
+	}
+
+	public static function resetRegistry() -> void
+	{
+		let self::registry = [];
+	}
 }
@@ -16,4 +16,71 @@ class Range
 	{
 		return 0...10;
 	}
-}
\ No newline at end of file
+
+	public function count(int a, int b) -> int
+	{
+		return count(a..b);
+	}
+
+	public function contains(int n, long a, long b) -> bool
+	{
+		return in_array(n, a..b);
+	}
+
+	public function containsStrict(int n, int a, int b) -> bool
+	{
+		return in_array(n, a...b, true);
+	}
+
+	public function sum(int a, int b)
+	{
+		return array_sum(a..b);
+	}
+
+	public function sumExclusive(long a, long b)
+	{
+		var sum;
+
+		let sum = array_sum(a...b);
+
+		return sum;
+	}
+
+	public function sumLiteral()
+	{
+		return array_sum(1..100);
+	}
+
+	public function walk(var a, var b) -> array
+	{
+		var i, values = [];
+
+		for i in a..b {
+			let values[] = i;
+		}
+
+		return values;
+	}
+
+	public function walkExclusive(int a, int b) -> array
+	{
+		var i, values = [];
+
+		for i in a...b {
+			let values[] = i;
+		}
+
+		return values;
+	}
+
+	public function walkReverse(int a, int b) -> array
+	{
+		var k, i, values = [];
+
+		for k, i in reverse a..b {
+			let values[k] = i;
+		}
+
+		return values;
+	}
+}
@@ -1,5 +1,10 @@
 namespace Test;
 
+%{
+// the stream hashes have no builtin, they are called from C blocks below
+#include "kernel/string.h"
+}%
+
 class Strings
 {
 	public function camelize(string str, var delimiter = null)
@@ -72,6 +77,36 @@ class Strings
 		return explode(",", str, limit);
 	}
 
+	public function testExplodeLoop(var delimiter, var str)
+	{
+		var piece, pieces = [];
+
+		for piece in explode(delimiter, str) {
+			let pieces[] = piece;
+		}
+
+		return pieces;
+	}
+
+	public function testExplodeLoopStr(var str)
+	{
+		var piece, pieces = [];
+
+		for piece in explode(",", str) {
+			if piece == "stop" {
+				break;
+			}
+			let pieces[] = piece;
+		}
+
+		return pieces;
+	}
+
+	public function testJoinExplode(var glue, var delimiter, var str)
+	{
+		return join(glue, explode(delimiter, str));
+	}
+
 	public function testSubstr(var str, int from, int len)
 	{
 		return substr(str, from, len);
@@ -112,6 +147,45 @@ class Strings
 		return hash_equals(str1, str2);
 	}
 
+	public function testMd5File(var filename) -> string
+	{
+		return md5(file_get_contents(filename));
+	}
+
+	public function testCrc32File(var filename) -> int
+	{
+		return crc32(file_get_contents(filename));
+	}
+
+	public function testMd5UniqueKey(var prefix, var value) -> string
+	{
+		return md5(unique_key(prefix, value));
+	}
+
+	public function testCrc32UniqueKey(var prefix, var value) -> int
+	{
+		return crc32(unique_key(prefix, value));
+	}
+
+	public function testUniqueKey(var prefix, var value) -> string
+	{
+		return unique_key(prefix, value);
+	}
+
+	public function testMd5Stream(var handle)
+	{
+		%{
+			zephir_md5_stream(return_value, handle);
+		}%
+	}
+
+	public function testCrc32Stream(var handle)
+	{
+		%{
+			zephir_crc32_stream(return_value, handle);
+		}%
+	}
+
 	public function testHardcodedMultilineString()
 	{
 		return "
@@ -262,4 +262,16 @@ class ArithmeticTest extends TestCase
         $this->assertFalse($this->class->letStatementBoolMinus(false));
         $this->assertFalse($this->class->letStatementBoolMinus(0));
     }
+
+    public function testVarArithmetic()
+    {
+        $this->assertSame(6, $this->class->mulVars(2, 3));
+        $this->assertSame(7.5, $this->class->mulVars(2.5, 3));
+        $this->assertSame(7.5, $this->class->mulVars(3, 2.5));
+        $this->assertSame(PHP_INT_MAX * 2, $this->class->mulVars(PHP_INT_MAX, 2));
+        $this->assertSame(6, $this->class->mulVars('2', '3'));
+        $this->assertSame(-1, $this->class->subVars(2, 3));
+        $this->assertSame(0.5, $this->class->subVars(3, 2.5));
+        $this->assertSame(PHP_INT_MIN - 1, $this->class->subVars(PHP_INT_MIN, 1));
+    }
 }
@@ -0,0 +1,150 @@
+<?php
+
+/*
+ * This file is part of the Zephir.
+ *
+ * (c) Zephir Team <team@zephir-lang.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code.
+ */
+
+namespace Extension\Bench;
+
+use PHPUnit\Framework\TestCase;
+use Test\Bench\HashEquals;
+
+/**
+ * Checks that hash_equals() takes the same time wherever the strings differ,
+ * with a Welch t-test between tokens differing in their first and in their
+ * last byte (as dudect does). Timings are too noisy on shared machines, so
+ * these tests only run with ZEPHIR_TIMING_TESTS=1.
+ */
+class HashEqualsTimingTest extends TestCase
+{
+    const SIZE = 4096;
+    const SAMPLES = 4000;
+    const BATCH = 100;
+
+    /* |t| above this means the two cases are distinguishable */
+    const THRESHOLD = 4.5;
+
+    public function setUp()
+    {
+        if (!getenv('ZEPHIR_TIMING_TESTS')) {
+            $this->markTestSkipped('Set ZEPHIR_TIMING_TESTS=1 to run the timing tests');
+        }
+    }
+
+    public function testTimeDoesNotDependOnMismatchPosition()
+    {
+        $known = str_repeat('a', self::SIZE);
+
+        $t = $this->measure(function ($user) use ($known) {
+            HashEquals::compare($known, $user, self::BATCH);
+        });
+
+        $this->assertLessThan(self::THRESHOLD, abs($t));
+    }
+
+    /**
+     * The comparison of PHP stops at the first difference, which the test
+     * must be able to tell
+     */
+    public function testEarlyExitIsDetected()
+    {
+        $known = str_repeat('a', self::SIZE);
+
+        $t = $this->measure(function ($user) use ($known) {
+            for ($i = 0; $i < self::BATCH; ++$i) {
+                $equal = $known === $user;
+            }
+        });
+
+        $this->assertGreaterThan(self::THRESHOLD, abs($t));
+    }
+
+    /**
+     * Times the callback on both cases in random order and returns the t statistic.
+     *
+     * @param callable $compare
+     *
+     * @return float
+     */
+    private function measure(callable $compare)
+    {
+        $users = [
+            'b'.str_repeat('a', self::SIZE - 1),
+            str_repeat('a', self::SIZE - 1).'b',
+        ];
+        $samples = [[], []];
+
+        $compare($users[0]);
+        $compare($users[1]);
+
+        for ($i = 0; $i < self::SAMPLES; ++$i) {
+            $class = mt_rand(0, 1);
+
+            $start = $this->now();
+            $compare($users[$class]);
+            $samples[$class][] = $this->now() - $start;
+        }
+
+        return $this->welch($this->crop($samples[0]), $this->crop($samples[1]));
+    }
+
+    /**
+     * Drops the slowest tenth of the samples, mostly interrupts and preemption.
+     *
+     * @param array $samples
+     *
+     * @return array
+     */
+    private function crop(array $samples)
+    {
+        sort($samples);
+
+        return \array_slice($samples, 0, (int) (\count($samples) * 0.9));
+    }
+
+    /**
+     * @param array $a
+     * @param array $b
+     *
+     * @return float
+     */
+    private function welch(array $a, array $b)
+    {
+        list($meanA, $varianceA) = $this->moments($a);
+        list($meanB, $varianceB) = $this->moments($b);
+
+        $error = sqrt($varianceA / \count($a) + $varianceB / \count($b));
+
+        return $error > 0 ? ($meanA - $meanB) / $error : 0.0;
+    }
+
+    /**
+     * @param array $samples
+     *
+     * @return float[] mean and variance
+     */
+    private function moments(array $samples)
+    {
+        $mean = array_sum($samples) / \count($samples);
+
+        $squares = 0.0;
+        foreach ($samples as $sample) {
+            $squares += ($sample - $mean) * ($sample - $mean);
+        }
+
+        return [$mean, $squares / (\count($samples) - 1)];
+    }
+
+    /**
+     * @return float nanoseconds
+     */
+    private function now()
+    {
+        return \function_exists('hrtime') ? (float) hrtime(true) : microtime(true) * 1e9;
+    }
+}
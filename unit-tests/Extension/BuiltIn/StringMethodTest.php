@@ -114,6 +114,11 @@ class StringMethodTest extends TestCase
         $this->assertSame('FOO', $t->getUpper('foo'));
         $this->assertSame('foo', $t->getLower('FOO'));
 
+        $mixed = str_repeat("Content-Type: Text/HTML; \xC3\xA9t\xC3\xA9 0123456789\0[@`{]", 3);
+        $this->assertSame(strtoupper($mixed), $t->getUpper($mixed));
+        $this->assertSame(strtolower($mixed), $t->getLower($mixed));
+        $this->assertSame('already lower case text without any capital letter', $t->getLower('already lower case text without any capital letter'));
+
         $this->assertSame('Foo', $t->getUpperFirst('foo'));
         $this->assertSame('fOO', $t->getLowerFirst('FOO'));
     }
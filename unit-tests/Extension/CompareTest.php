@@ -71,4 +71,35 @@ class CompareTest extends TestCase
         $this->assertTrue($t->testNotIdenticalZeroInt());
         $this->assertTrue($t->testNotIdenticalZeroLong());
     }
+
+    public function testVarNumberCompare()
+    {
+        $t = new Compare();
+
+        foreach ([2, 2.0, 2.3, 2.5, 3, '2.5', null, true] as $a) {
+            $expected = [
+                $a < 2.5, $a > 2.5, $a <= 2, $a >= 2, $a == 2.5,
+                $a != 2.5, $a === 2.0, $a !== 2.0, 2.5 < $a, 2.5 == $a,
+            ];
+            $this->assertSame($expected, $t->testVarNumberCompare($a));
+        }
+    }
+
+    public function testVarVarCompare()
+    {
+        $t = new Compare();
+
+        $pairs = [[1, 2], [2, 2], [2, 2.0], [2.5, 2], [1.5, 2.5], ['10', '9'], ['abc', 'abd'], ['1e3', '1000'], [null, 0]];
+        foreach ($pairs as list($a, $b)) {
+            $this->assertSame([$a < $b, $a <= $b, $a > $b, $a >= $b, $a == $b, $a != $b], $t->testVarVarCompare($a, $b));
+        }
+    }
+
+    public function testTypeSpeculation()
+    {
+        $t = new Compare();
+
+        $this->assertSame(10, $t->testDoubleVarCompare(20));
+        $this->assertSame(4, $t->testCountInference([1, 2, 3]));
+    }
 }
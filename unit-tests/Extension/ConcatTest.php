@@ -53,4 +53,101 @@ class ConcatTest extends TestCase
         $t = new Concat();
         $this->assertSame('21', $t->testConcat3());
     }
+
+    /** @test */
+    public function shouldConcatenateScalarTypedOperands()
+    {
+        $t = new Concat();
+        $this->assertSame('id=-42&price=1.5&qty=10;', $t->testConcat4(-42, 1.5, '&'));
+        $this->assertSame('id='.PHP_INT_MAX.',price='.(1 / 3).',qty=10;', $t->testConcat4(PHP_INT_MAX, 1 / 3, ','));
+    }
+
+    /**
+     * @test
+     * @dataProvider doubleProvider
+     */
+    public function shouldConcatenateDoublesLikePhp($number)
+    {
+        $t = new Concat();
+        $this->assertSame('['.$number.']', $t->testConcatDouble($number));
+    }
+
+    public function doubleProvider()
+    {
+        return [
+            'large' => [1e20],
+            'small' => [1e-10],
+            'exponent' => [1.5e300],
+            'negative zero' => [-0.0],
+            'infinity' => [INF],
+            'negative infinity' => [-INF],
+            'nan' => [NAN],
+            'fraction' => [1 / 3],
+        ];
+    }
+
+    /** @test */
+    public function shouldConcatenateDoublesWithSerializePrecision()
+    {
+        if (\PHP_VERSION_ID < 70100) {
+            $this->markTestSkipped('precision=-1 requires PHP 7.1 or newer');
+        }
+
+        $t = new Concat();
+        $precision = ini_set('precision', '-1');
+
+        try {
+            $this->assertSame('[0.1]', $t->testConcatDouble(0.1));
+            $this->assertSame('['.(1 / 3).']', $t->testConcatDouble(1 / 3));
+        } finally {
+            ini_set('precision', $precision);
+        }
+    }
+
+    /**
+     * @test
+     * @dataProvider precisionProvider
+     */
+    public function shouldConcatenateDoublesAtEveryPrecision($precision)
+    {
+        $t = new Concat();
+        $previous = ini_set('precision', $precision);
+
+        try {
+            foreach ([-1 / 3, -1.2345678901234567e-308, 0.00012345678901234567, 1.5e300, 123456789.125] as $number) {
+                $this->assertSame('['.$number.']', $t->testConcatDouble($number));
+            }
+        } finally {
+            ini_set('precision', $previous);
+        }
+    }
+
+    public function precisionProvider()
+    {
+        return [
+            'default' => ['14'],
+            'zero' => ['0'],
+            'one' => ['1'],
+            'largest on the stack' => ['17'],
+            'on the heap' => ['18'],
+            'very high' => ['40'],
+        ];
+    }
+
+    /** @test */
+    public function shouldConcatenateUnsignedIntegersAboveLongMax()
+    {
+        $t = new Concat();
+        $this->assertSame('[42]', $t->testConcatUnsigned(42));
+        $this->assertSame('['.sprintf('%u', -1).']', $t->testConcatUnsigned(-1));
+        $this->assertSame('['.sprintf('%u', PHP_INT_MIN).']', $t->testConcatUnsigned(PHP_INT_MIN));
+    }
+
+    /** @test */
+    public function shouldConcatenateLongBoundaries()
+    {
+        $t = new Concat();
+        $this->assertSame('['.PHP_INT_MAX.']', $t->testConcatLong(PHP_INT_MAX));
+        $this->assertSame('['.PHP_INT_MIN.']', $t->testConcatLong(PHP_INT_MIN));
+    }
 }
@@ -35,4 +35,48 @@ class SwitchFlowTest extends TestCase
         $this->assertSame(0, $t->testSwitch12(6, 10));
         $this->assertSame(2, $t->testSwitch12(2, 3));
     }
+
+    public function testSwitchDispatch()
+    {
+        $t = new SwitchFlow();
+
+        $this->assertSame(12, $t->testSwitchInt(1));
+        $this->assertSame(12, $t->testSwitchInt(2));
+        $this->assertSame(3, $t->testSwitchInt(3));
+        $this->assertSame(-4, $t->testSwitchInt(-4));
+        $this->assertSame(100, $t->testSwitchInt(100));
+        $this->assertSame(0, $t->testSwitchInt(5));
+
+        $this->assertSame('vowel', $t->testSwitchChar('e'));
+        $this->assertSame('space', $t->testSwitchChar("\n"));
+        $this->assertSame('other', $t->testSwitchChar('x'));
+
+        $this->assertSame(10, $t->testSwitchLongLabels(0));
+        $this->assertSame(12, $t->testSwitchLongLabels(3));
+        $this->assertSame(13, $t->testSwitchLongLabels(40));
+        $this->assertSame(-1, $t->testSwitchLongLabels(41));
+        $this->assertSame(12, $t->testSwitchLongLabels(2.0));
+        $this->assertSame(-1, $t->testSwitchLongLabels(2.5));
+        $this->assertSame(12, $t->testSwitchLongLabels('3'));
+        $this->assertSame(11, $t->testSwitchLongLabels(true));
+        $this->assertSame(10, $t->testSwitchLongLabels(null));
+        $this->assertSame(-1, $t->testSwitchLongLabels([]));
+
+        $this->assertSame(1, $t->testSwitchStringLabels('GET'));
+        $this->assertSame(2, $t->testSwitchStringLabels('PUT'));
+        $this->assertSame(3, $t->testSwitchStringLabels('POST'));
+        $this->assertSame(3, $t->testSwitchStringLabels('PATCH'));
+        $this->assertSame(4, $t->testSwitchStringLabels('HEAD'));
+        $this->assertSame(5, $t->testSwitchStringLabels('DELETE'));
+        $this->assertSame(6, $t->testSwitchStringLabels(''));
+        $this->assertSame(7, $t->testSwitchStringLabels('1'));
+        $this->assertSame(8, $t->testSwitchStringLabels('a"b'));
+        $this->assertSame(0, $t->testSwitchStringLabels('GOT'));
+        $this->assertSame(0, $t->testSwitchStringLabels('get'));
+        $this->assertSame(6, $t->testSwitchStringLabels(null));
+        $this->assertSame(7, $t->testSwitchStringLabels(true));
+        $this->assertSame(0, $t->testSwitchStringLabels(1));
+
+        $this->assertSame(23, $t->testSwitchStringLoop(['GET', 'POST', 'HEAD', 'PUT', 'OPTIONS', 'GET']));
+    }
 }
@@ -24,4 +24,42 @@ class InstanceTest extends TestCase
     {
         $this->assertInstanceOf(Instance::class, Instance::testIssue1339());
     }
+
+    /** @test */
+    public function shouldCreateInstancesOfChangingClasses()
+    {
+        $classNames = ['ArrayObject', 'stdClass', 'arrayobject', 'SplObjectStorage', 'stdClass', 'STDCLASS'];
+        $instances = Instance::testCreateInstances($classNames);
+
+        $this->assertCount(\count($classNames), $instances);
+        foreach ($classNames as $i => $className) {
+            $this->assertInstanceOf($className, $instances[$i]);
+        }
+    }
+
+    /** @test */
+    public function shouldCreateInstancesPassingParameters()
+    {
+        $packed = Instance::testCreateInstancesParams('ArrayObject', [[1, 2, 3]], 3);
+        $this->assertCount(3, $packed);
+        $this->assertSame([1, 2, 3], $packed[2]->getArrayCopy());
+
+        $holes = [[4], [5, 6]];
+        unset($holes[0]);
+        $instances = Instance::testCreateInstancesParams('ArrayObject', $holes, 2);
+        $this->assertSame([5, 6], $instances[1]->getArrayCopy());
+
+        $instances = Instance::testCreateInstancesParams('ArrayObject', ['input' => ['a' => 1]], 2);
+        $this->assertSame(['a' => 1], $instances[1]->getArrayCopy());
+    }
+
+    /**
+     * @test
+     * @expectedException \RuntimeException
+     * @expectedExceptionMessage Invalid class name
+     */
+    public function shouldThrowExceptionOnInvalidClassName()
+    {
+        Instance::testCreateInstances([1]);
+    }
 }
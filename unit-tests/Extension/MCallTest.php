@@ -165,6 +165,33 @@ class MCallTest extends TestCase
         $this->assertInstanceOf('Test\Oo\Param', $t->objectParamCastOoParam(new \Test\Oo\Param()));
     }
 
+    public function testCallPolymorphic()
+    {
+        $t = new Mcall();
+        $objects = [];
+        $expected = [];
+
+        // More receiver classes than the inline cache entries of the call site
+        foreach (range(1, 6) as $i) {
+            $object = eval('return new class() { public function getName() { return "class'.$i.'"; } };');
+            $objects[] = $object;
+            $objects[] = $object;
+            $expected[] = 'class'.$i;
+            $expected[] = 'class'.$i;
+        }
+
+        $objects[] = new class() {
+            public function __call($name, $arguments)
+            {
+                return '__call:'.$name;
+            }
+        };
+        $expected[] = '__call:getName';
+
+        $this->assertSame($expected, $t->callPolymorphic($objects));
+        $this->assertSame(array_reverse($expected), $t->callPolymorphic(array_reverse($objects)));
+    }
+
     /**
      * @return \ReflectionParameter
      */
@@ -72,4 +72,32 @@ class MethodArgsTest extends TestCase
         $this->assertSame(MethodArgs::MY_BOOL, $t->methodOptionalBoolValueWithDefaultStaticConstantAccess());
         $this->assertSame(MethodArgs::MY_INT, $t->methodOptionalIntValueWithDefaultStaticConstantAccess());
     }
+
+    public function testWrongNumberOfParameters()
+    {
+        $t = new MethodArgs();
+
+        try {
+            $t->methodOptionalValueWithDefaultStaticConstantAccess('test', 'extra');
+            $this->fail('Expected a BadMethodCallException');
+        } catch (\BadMethodCallException $e) {
+            $this->assertSame('Wrong number of parameters', $e->getMessage());
+        }
+    }
+
+    public function testWrongNumberOfParametersWithoutMemoryFrame()
+    {
+        $t = new MethodArgs();
+
+        try {
+            $t->setObject(new \stdClass(), 'extra');
+            $this->fail('Expected a BadMethodCallException');
+        } catch (\BadMethodCallException $e) {
+            $this->assertSame('Wrong number of parameters', $e->getMessage());
+        }
+
+        $this->expectException(\BadMethodCallException::class);
+
+        $t->setObject();
+    }
 }
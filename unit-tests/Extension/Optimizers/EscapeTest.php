@@ -0,0 +1,100 @@
+<?php
+
+/*
+ * This file is part of the Zephir.
+ *
+ * (c) Zephir Team <team@zephir-lang.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code.
+ */
+
+namespace Extension\Optimizers;
+
+use PHPUnit\Framework\TestCase;
+use Test\Optimizers\Escape;
+
+class EscapeTest extends TestCase
+{
+    public function escapeProvider()
+    {
+        return [
+            'alphanumeric' => ['Zephir2019', 'Zephir2019', 'Zephir2019'],
+            'ascii' => ["a, b'c", 'a\2c \20 b\27 c', 'a, b\x27c'],
+            'two bytes' => ['wörld', 'w\f6 rld', 'w\xf6rld'],
+            'three bytes' => ['5 €', '5\20 \20ac ', '5 \x20ac'],
+            'four bytes' => ["\u{1F600}!", '\1f600 \21 ', '\x1f600!'],
+        ];
+    }
+
+    /**
+     * @dataProvider escapeProvider
+     */
+    public function testEscapeUtf8($value, $css, $js)
+    {
+        $this->assertSame($css, Escape::cssUtf8($value));
+        $this->assertSame($js, Escape::jsUtf8($value));
+    }
+
+    /**
+     * @dataProvider escapeProvider
+     */
+    public function testEscapeUtf32($value, $css, $js)
+    {
+        if (!\extension_loaded('mbstring')) {
+            $this->markTestSkipped('The mbstring extension is not loaded');
+        }
+
+        $value = mb_convert_encoding($value, 'UTF-32BE', 'UTF-8');
+
+        $this->assertSame($css, Escape::css($value));
+        $this->assertSame($js, Escape::js($value));
+    }
+
+    public function testEscapeNonStringValues()
+    {
+        $this->assertSame('\2d 1\2e 5', Escape::cssUtf8(-1.5));
+        $this->assertSame('-1.5', Escape::jsUtf8(-1.5));
+    }
+
+    public function invalidUtf8Provider()
+    {
+        return [
+            'empty' => [''],
+            'truncated sequence' => ["ab\xC3"],
+            'invalid continuation' => ["\xC3\x28"],
+            'overlong encoding' => ["\xC0\xAF"],
+            'surrogate' => ["\xED\xA0\x80"],
+            'above U+10FFFF' => ["\xF4\x90\x80\x80"],
+            'lone continuation' => ["a\x80b"],
+            'null character' => ["a\0b"],
+        ];
+    }
+
+    /**
+     * @dataProvider invalidUtf8Provider
+     */
+    public function testEscapeInvalidUtf8($value)
+    {
+        $this->assertFalse(Escape::cssUtf8($value));
+        $this->assertFalse(Escape::jsUtf8($value));
+    }
+
+    public function invalidUtf32Provider()
+    {
+        return [
+            'empty' => [''],
+            'not a multiple of four bytes' => ["\0\0\0a\0"],
+            'null character' => ["\0\0\0a\0\0\0\0"],
+        ];
+    }
+
+    /**
+     * @dataProvider invalidUtf32Provider
+     */
+    public function testEscapeInvalidUtf32($value)
+    {
+        $this->assertFalse(Escape::css($value));
+        $this->assertFalse(Escape::js($value));
+    }
+}
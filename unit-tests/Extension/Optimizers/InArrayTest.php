@@ -0,0 +1,70 @@
+<?php
+
+/*
+ * This file is part of the Zephir.
+ *
+ * (c) Zephir Team <team@zephir-lang.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code.
+ */
+
+namespace Extension\Optimizers;
+
+use PHPUnit\Framework\TestCase;
+use Test\Optimizers\InArray;
+
+class InArrayTest extends TestCase
+{
+    public function testFind()
+    {
+        $this->assertTrue(InArray::find('b', ['a', 'b']));
+        $this->assertFalse(InArray::find('c', ['a', 'b']));
+        $this->assertTrue(InArray::find('1', [1, 2]));
+        $this->assertTrue(InArray::findStrict(1, [1, 2]));
+        $this->assertFalse(InArray::findStrict('1', [1, 2]));
+    }
+
+    /**
+     * @dataProvider providerHaystacks
+     *
+     * @param array $needles
+     * @param array $haystack
+     */
+    public function testFilter(array $needles, array $haystack)
+    {
+        $loose = array_values(array_filter($needles, function ($needle) use ($haystack) {
+            return \in_array($needle, $haystack);
+        }));
+        $strict = array_values(array_filter($needles, function ($needle) use ($haystack) {
+            return \in_array($needle, $haystack, true);
+        }));
+
+        $this->assertSame($loose, InArray::filter($needles, $haystack));
+        $this->assertSame($strict, InArray::filterStrict($needles, $haystack));
+    }
+
+    public function providerHaystacks()
+    {
+        $needles = ['a', 'h', 'z', '1', '10', '1e1', '010', ' 1', '', 'abc', 0, 1, 10, 11, 1.0, true, false, null];
+
+        return [
+            'small' => [$needles, ['a', 'b', 'c']],
+            'strings' => [$needles, ['a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'abc']],
+            'numeric strings' => [$needles, ['a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', '1.0', '10']],
+            'integers' => [$needles, [1, 2, 3, 4, 5, 6, 7, 8, 9, 10]],
+            'mixed' => [$needles, ['a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 1, 10]],
+            'others' => [$needles, ['a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 2.5, null]],
+            'needles' => [range(1, 100), range(50, 150)],
+        ];
+    }
+
+    public function testHaystackChangedInLoop()
+    {
+        $haystack = range(1, 20);
+        $needles = [1, 2, 20, 5, 3, 20];
+
+        $this->assertSame([1, 2, 20, 5, 20], InArray::filterShrinking($needles, $haystack));
+        $this->assertSame(range(1, 20), $haystack);
+    }
+}
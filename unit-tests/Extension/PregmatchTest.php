@@ -85,4 +85,36 @@ class PregmatchTest extends TestCase
         $this->assertSame($arr[0], [['test1', 'test2'], ['test1', 'test2']]);
         $this->assertSame($arr[1], [['test1', 'test1'], ['test2', 'test2']]);
     }
+
+    public function testLiteralPattern()
+    {
+        $t = new Pregmatch();
+        $this->assertSame(1, $t->testLiteralPattern('abc123'));
+        $this->assertSame(0, $t->testLiteralPattern('123abc'));
+        $this->assertSame(['abc123', 'abc', '123'], $t->testLiteralPatternMatches('--abc123--'));
+        $this->assertSame([], $t->testLiteralPatternMatches('---'));
+        $this->assertSame(2, $t->testLiteralPatternInLoop(['a1', 'b', 'c2', '3']));
+    }
+
+    public function testLiteralPatternLocale()
+    {
+        $t = new Pregmatch();
+        $locale = setlocale(LC_CTYPE, 0);
+
+        $this->assertSame(0, $t->testLiteralAlphaPattern("caf\xE9"));
+
+        if (false === setlocale(LC_CTYPE, 'de_DE.ISO-8859-1', 'de_DE.ISO8859-1', 'fr_FR.ISO-8859-1', 'fr_FR.ISO8859-1')) {
+            $this->markTestSkipped('No ISO-8859-1 locale is available');
+        }
+
+        try {
+            $expected = preg_match('/^[[:alpha:]]+$/', "caf\xE9");
+            $this->assertSame(1, $expected);
+            $this->assertSame($expected, $t->testLiteralAlphaPattern("caf\xE9"));
+        } finally {
+            setlocale(LC_CTYPE, $locale);
+        }
+
+        $this->assertSame(0, $t->testLiteralAlphaPattern("caf\xE9"));
+    }
 }
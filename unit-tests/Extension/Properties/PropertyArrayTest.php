@@ -24,6 +24,28 @@ class PropertyArrayTest extends TestCase
         $this->assertSame([1, 'one'], $t->someArray);
     }
 
+    public function testConstantDefaultsAreCopiedOnWrite()
+    {
+        $map = ['one' => 1, 'two' => [2.5, true, null, 'two'], 3 => 'three'];
+
+        $first = new PropertyArray();
+        $second = new PropertyArray();
+        $this->assertSame([], $first->someEmptyArray);
+        $this->assertSame($map, $first->someMap);
+
+        $first->someEmptyArray[] = 'first';
+        $first->setSomeMapItem('one', 'first');
+        $second->someMap['two'][] = 'second';
+
+        $this->assertSame(['first'], $first->someEmptyArray);
+        $this->assertSame([], $second->someEmptyArray);
+        $this->assertSame('first', $first->someMap['one']);
+        $this->assertSame(1, $second->someMap['one']);
+        $this->assertSame([2.5, true, null, 'two'], $first->someMap['two']);
+        $this->assertSame([2.5, true, null, 'two', 'second'], $second->someMap['two']);
+        $this->assertSame($map, (new PropertyArray())->someMap);
+    }
+
     public function testIssues1831()
     {
         $header = [
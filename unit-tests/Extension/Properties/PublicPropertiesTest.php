@@ -39,6 +39,18 @@ class PublicPropertiesTest extends TestCase
         $this->assertTrue($t->test394Issue());
     }
 
+    public function testShouldAccessDeclaredPropertiesOfSubclasses()
+    {
+        $t = new PublicProperties();
+        $this->assertSame(['test', 10], $t->swapSomeIntegerAndString());
+        $this->assertSame('test', $t->someInteger);
+        $this->assertSame(10, $t->someString);
+
+        $t = new ExtendsPublicProperties();
+        $this->assertSame(['test', 10], $t->swapSomeIntegerAndString());
+        $this->assertSame(10, $t->someString);
+    }
+
     /**
      * @see https://github.com/phalcon/zephir/issues/537
      */
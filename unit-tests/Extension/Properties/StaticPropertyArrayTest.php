@@ -21,4 +21,31 @@ class StaticPropertyArrayTest extends TestCase
         $this->assertSame([], StaticPropertyArray::$someEmptyArray);
         $this->assertSame([1, 2, 3, 4], StaticPropertyArray::$someArray);
     }
+
+    public function testUpdateInPlace()
+    {
+        StaticPropertyArray::resetRegistry();
+
+        StaticPropertyArray::register('a', 1);
+        $copy = StaticPropertyArray::getRegistry();
+        StaticPropertyArray::register('b', 2);
+        StaticPropertyArray::registerNested('c', 'd', 3);
+        StaticPropertyArray::registerNested('c', 'e', 4);
+
+        $this->assertSame(['a' => 1], $copy);
+        $this->assertSame(['a' => 1, 'b' => 2, 'c' => ['d' => 3, 'e' => 4]], StaticPropertyArray::getRegistry());
+
+        StaticPropertyArray::resetRegistry();
+        $this->assertSame(1000, StaticPropertyArray::fill(1000));
+        $this->assertSame(500, StaticPropertyArray::getRegistry()['item500']);
+    }
+
+    public function testUpdateDefaultAndNull()
+    {
+        StaticPropertyArray::setDefault('c', 3);
+        $this->assertSame(['a' => 1, 'b' => 2, 'c' => 3], StaticPropertyArray::$defaults);
+
+        $this->assertSame(['x' => 1], StaticPropertyArray::registerLazy('x', 1));
+        $this->assertSame(['x' => 1, 'y' => 2], StaticPropertyArray::registerLazy('y', 2));
+    }
 }
@@ -0,0 +1,137 @@
+<?php
+
+/*
+ * This file is part of the Zephir.
+ *
+ * (c) Zephir Team <team@zephir-lang.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code.
+ */
+
+namespace Extension;
+
+use PHPUnit\Framework\TestCase;
+use Test\Range;
+
+class RangeTest extends TestCase
+{
+    public function testLiteral()
+    {
+        $t = new Range();
+
+        $this->assertSame(range(0, 10), $t->inclusive1());
+        $this->assertSame(range(0, 10), $t->exclusive1());
+    }
+
+    /**
+     * @dataProvider providerBounds
+     *
+     * @param int $a
+     * @param int $b
+     */
+    public function testCount($a, $b)
+    {
+        $t = new Range();
+
+        $this->assertSame(\count(range($a, $b)), $t->count($a, $b));
+    }
+
+    /**
+     * @dataProvider providerBounds
+     *
+     * @param int $a
+     * @param int $b
+     */
+    public function testContains($a, $b)
+    {
+        $t = new Range();
+
+        foreach ([$a - 1, $a, $b, $b + 1, (int) (($a + $b) / 2)] as $n) {
+            $this->assertSame(\in_array($n, range($a, $b)), $t->contains($n, $a, $b));
+            $this->assertSame(\in_array($n, range($a, $b), true), $t->containsStrict($n, $a, $b));
+        }
+    }
+
+    /**
+     * @dataProvider providerBounds
+     *
+     * @param int $a
+     * @param int $b
+     */
+    public function testSum($a, $b)
+    {
+        $t = new Range();
+
+        $this->assertSame(array_sum(range($a, $b)), $t->sum($a, $b));
+        $this->assertSame(array_sum(range($a, $b)), $t->sumExclusive($a, $b));
+    }
+
+    public function testSumLiteral()
+    {
+        $t = new Range();
+
+        $this->assertSame(5050, $t->sumLiteral());
+    }
+
+    /**
+     * @dataProvider providerSumBounds
+     *
+     * @param int $a
+     * @param int $b
+     */
+    public function testSumLimits($a, $b)
+    {
+        $t = new Range();
+
+        $this->assertSame(array_sum(range($a, $b)), $t->sum($a, $b));
+    }
+
+    public function providerSumBounds()
+    {
+        $third = intdiv(PHP_INT_MAX, 3);
+
+        return [
+            'large' => [-1000000, 1000001],
+            'largest' => [PHP_INT_MAX, PHP_INT_MAX],
+            'smallest' => [PHP_INT_MIN, PHP_INT_MIN],
+            'sum of the bounds overflows' => [PHP_INT_MAX - 2, PHP_INT_MAX],
+            'sum of the bounds underflows' => [PHP_INT_MIN + 2, PHP_INT_MIN],
+            'product overflows' => [$third + 1, $third + 3],
+            'product fits' => [$third - 3, $third - 1],
+            'near the smallest' => [PHP_INT_MIN, PHP_INT_MIN + 3],
+        ];
+    }
+
+    /**
+     * @dataProvider providerBounds
+     *
+     * @param int $a
+     * @param int $b
+     */
+    public function testWalk($a, $b)
+    {
+        $t = new Range();
+
+        $this->assertSame(range($a, $b), $t->walk($a, $b));
+        $this->assertSame(range($a, $b), $t->walkExclusive($a, $b));
+    }
+
+    public function testWalkReverse()
+    {
+        $t = new Range();
+
+        $this->assertSame([4 => 5, 3 => 4, 2 => 3, 1 => 2, 0 => 1], $t->walkReverse(1, 5));
+        $this->assertSame([2 => -1, 1 => 0, 0 => 1], $t->walkReverse(1, -1));
+    }
+
+    public function providerBounds()
+    {
+        return [
+            [0, 10],
+            [10, 0],
+            [-3, 3],
+            [7, 7],
+        ];
+    }
+}
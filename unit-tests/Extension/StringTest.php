@@ -47,6 +47,134 @@ class StringTest extends TestCase
         $this->assertFalse($t->testHashEquals($knownString, $userString));
     }
 
+    public function testHashEqualsEveryPosition()
+    {
+        $t = new \Test\Strings();
+
+        foreach ([1, 7, 8, 15, 16, 31, 32, 33, 100] as $length) {
+            $known = str_repeat('x', $length);
+            $this->assertTrue($t->testHashEquals($known, str_repeat('x', $length)));
+
+            for ($i = 0; $i < $length; ++$i) {
+                $user = $known;
+                $user[$i] = 'y';
+                $this->assertFalse($t->testHashEquals($known, $user));
+            }
+        }
+    }
+
+    public function testHashFile()
+    {
+        $t = new \Test\Strings();
+
+        $filename = tempnam(sys_get_temp_dir(), 'zephir');
+        foreach ([0, 1, 8191, 8192, 8193, 100000] as $length) {
+            file_put_contents($filename, random_bytes($length));
+
+            $this->assertSame(md5_file($filename), $t->testMd5File($filename));
+            $this->assertSame(crc32(file_get_contents($filename)), $t->testCrc32File($filename));
+        }
+        unlink($filename);
+    }
+
+    public function testHashMissingFile()
+    {
+        $t = new \Test\Strings();
+
+        $this->assertSame(md5(''), @$t->testMd5File('/non/existent/file'));
+        $this->assertSame(0, @$t->testCrc32File('/non/existent/file'));
+    }
+
+    /**
+     * @dataProvider providerHashStream
+     *
+     * @param mixed $value
+     */
+    public function testHashStream($value)
+    {
+        $t = new \Test\Strings();
+
+        $handle = fopen('php://temp', 'w+b');
+        fwrite($handle, 'skipped'.$value);
+
+        fseek($handle, 7);
+        $this->assertSame(md5((string) $value), $t->testMd5Stream($handle));
+
+        fseek($handle, 7);
+        $this->assertSame(crc32((string) $value), $t->testCrc32Stream($handle));
+
+        fclose($handle);
+    }
+
+    public function providerHashStream()
+    {
+        return [
+            ['value'],
+            [''],
+            [12345],
+            [-1.5],
+            [true],
+            [false],
+            [null],
+            [str_repeat('a', 8191)],
+            [str_repeat('a', 8192)],
+            [str_repeat('a', 8193)],
+            [random_bytes(100000)],
+        ];
+    }
+
+    public function testHashStreamInvalid()
+    {
+        $t = new \Test\Strings();
+
+        $this->assertFalse(@$t->testMd5Stream('value'));
+        $this->assertFalse(@$t->testCrc32Stream(12345));
+    }
+
+    public function testHashStreamReadFailure()
+    {
+        if (\PHP_VERSION_ID < 70400) {
+            $this->markTestSkipped('Stream reads report their failures as of PHP 7.4');
+        }
+
+        $t = new \Test\Strings();
+
+        $filename = tempnam(sys_get_temp_dir(), 'zephir');
+        $handle = fopen($filename, 'wb');
+
+        $this->assertFalse(@$t->testMd5Stream($handle));
+        $this->assertFalse(@$t->testCrc32Stream($handle));
+
+        fclose($handle);
+        unlink($filename);
+    }
+
+    /**
+     * @dataProvider providerUniqueKey
+     *
+     * @param mixed $prefix
+     * @param mixed $value
+     */
+    public function testHashUniqueKey($prefix, $value)
+    {
+        $t = new \Test\Strings();
+
+        $key = $t->testUniqueKey($prefix, $value);
+        $this->assertSame(md5($key), $t->testMd5UniqueKey($prefix, $value));
+        $this->assertSame(crc32($key), $t->testCrc32UniqueKey($prefix, $value));
+    }
+
+    public function providerUniqueKey()
+    {
+        return [
+            ['prefix', 'value'],
+            ['prefix', 12345],
+            [null, 1.5],
+            ['prefix', [1, 'a', [true, null], new \stdClass(), 2.5]],
+            ['', []],
+        ];
+    }
+
     /**
      * @dataProvider providerCamelize
      *
@@ -175,6 +303,43 @@ class StringTest extends TestCase
         $this->assertSame($ar3[2], 'piece3,piece4,piece5,piece6');
     }
 
+    /**
+     * @dataProvider providerExplode
+     *
+     * @param string $delimiter
+     * @param string $str
+     */
+    public function testExplodeLoop($delimiter, $str)
+    {
+        $t = new \Test\Strings();
+
+        $this->assertSame(explode($delimiter, $str), $t->testExplodeLoop($delimiter, $str));
+        $this->assertSame(implode('; ', explode($delimiter, $str)), $t->testJoinExplode('; ', $delimiter, $str));
+        $this->assertSame($str, $t->testJoinExplode($delimiter, $delimiter, $str));
+    }
+
+    public function providerExplode()
+    {
+        return [
+            [',', 'piece1,piece2,piece3'],
+            [',', ''],
+            [',', ','],
+            [',', 'no delimiter'],
+            [',', ',,leading,,and trailing,,'],
+            ['::', 'a::b:::c::'],
+            ["\r\n", "Host: example.com\r\nAccept: */*\r\n\r\n"],
+            ['/', str_repeat('segment/', 1000)],
+        ];
+    }
+
+    public function testExplodeLoopBreak()
+    {
+        $t = new \Test\Strings();
+
+        $this->assertSame(['a', '', 'b'], $t->testExplodeLoopStr('a,,b,stop,c'));
+        $this->assertSame(['a', 'b', 'c'], $t->testExplodeLoopStr('a,b,c'));
+    }
+
     public function testSubstr()
     {
         $t = new \Test\Strings();
@@ -294,6 +459,12 @@ class StringTest extends TestCase
             ['came.li.ze',      'CameLiZe',  '.'],
             ['came-li-ze',      'CameLiZe',  '-'],
             ['c+a+m+e+l+i+z+e', 'CAMELIZE',  '+'],
+            [
+                'content_TYPE-x_forwarded_for_content_type_x_forwarded_for',
+                'ContentTypeXForwardedForContentTypeXForwardedFor',
+                null,
+            ],
+            ['__', '', '_'],
         ];
     }
 
@@ -309,6 +480,12 @@ class StringTest extends TestCase
             ['CameLiZe',  'came.li.ze',      '.'],
             ['CameLiZe',  'came-li-ze',      '-'],
             ['CAMELIZE',  'c/a/m/e/l/i/z/e', '/'],
+            [
+                'ContentTypeXForwardedForContentTypeXForwardedFor',
+                'content_type_x_forwarded_for_content_type_x_forwarded_for',
+                null,
+            ],
+            ["long_lowercase_identifier_without_capitals\0Ignored", 'long_lowercase_identifier_without_capitals', null],
         ];
     }
 
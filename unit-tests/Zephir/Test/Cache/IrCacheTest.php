@@ -0,0 +1,75 @@
+<?php
+
+/*
+ * This file is part of the Zephir.
+ *
+ * (c) Zephir Team <team@zephir-lang.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code.
+ */
+
+namespace Zephir\Test\Cache;
+
+use PHPUnit\Framework\TestCase;
+use Zephir\Cache\IrCache;
+use Zephir\Test\FileSystem\MemoryFileSystemTrait;
+
+class IrCacheTest extends TestCase
+{
+    use MemoryFileSystemTrait;
+
+    /** @test */
+    public function shouldValidateEntriesByContentHash()
+    {
+        $ir = [['type' => 'namespace', 'name' => 'Test']];
+
+        $cache = new IrCache($this->createFileSystem(), '1.3.0');
+        $this->assertNull($cache->get('/test/a.zep', 'hash1'));
+        $cache->set('/test/a.zep', 'hash1', $ir);
+        $cache->save();
+
+        $cache = new IrCache($this->createFileSystem(), '1.3.0');
+        $this->assertSame($ir, $cache->get('/test/a.zep', 'hash1'));
+        $this->assertNull($cache->get('/test/a.zep', 'hash2'));
+        $this->assertNull($cache->get('/test/b.zep', 'hash1'));
+        $this->assertSame(1, $cache->getHits());
+        $this->assertSame(2, $cache->getMisses());
+    }
+
+    /** @test */
+    public function shouldDropEntriesOfDeletedFiles()
+    {
+        $ir = [['type' => 'namespace', 'name' => 'Test']];
+        $existing = tempnam(sys_get_temp_dir(), 'zep');
+
+        $cache = new IrCache($this->createFileSystem(), '1.3.0');
+        $cache->set('/test/a.zep', 'hash1', $ir);
+        $cache->set('/test/deleted.zep', 'hash2', $ir);
+        $cache->set($existing, 'hash3', $ir);
+        $cache->save();
+
+        /* Only a.zep is compiled, deleted.zep was removed from the project */
+        $cache = new IrCache($this->createFileSystem(), '1.3.0');
+        $this->assertSame($ir, $cache->get('/test/a.zep', 'hash1'));
+        $cache->save();
+
+        $cache = new IrCache($this->createFileSystem(), '1.3.0');
+        $this->assertSame($ir, $cache->get('/test/a.zep', 'hash1'));
+        $this->assertSame($ir, $cache->get($existing, 'hash3'));
+        $this->assertNull($cache->get('/test/deleted.zep', 'hash2'));
+
+        unlink($existing);
+    }
+
+    /** @test */
+    public function shouldDiscardCacheOfOtherParserVersion()
+    {
+        $cache = new IrCache($this->createFileSystem(), '1.3.0');
+        $cache->set('/test/a.zep', 'hash1', [['type' => 'namespace', 'name' => 'Test']]);
+        $cache->save();
+
+        $cache = new IrCache($this->createFileSystem(), '1.3.1');
+        $this->assertNull($cache->get('/test/a.zep', 'hash1'));
+    }
+}
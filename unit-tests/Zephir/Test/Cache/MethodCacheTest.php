@@ -0,0 +1,144 @@
+<?php
+
+/*
+ * This file is part of the Zephir.
+ *
+ * (c) Zephir Team <team@zephir-lang.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code.
+ */
+
+namespace Zephir\Test\Cache;
+
+use PHPUnit\Framework\TestCase;
+use Zephir\Cache\MethodCache;
+use Zephir\Cache\SlotsCache;
+use Zephir\ClassDefinition;
+use Zephir\ClassMethod;
+use Zephir\CompilationContext;
+use Zephir\Passes\CallGathererPass;
+use Zephir\SymbolTable;
+use Zephir\Variable;
+
+class MethodCacheTest extends TestCase
+{
+    /** @test */
+    public function shouldDeclareFunctionCacheForRepeatedCalls()
+    {
+        $symbolTable = $this->createMock(SymbolTable::class);
+        $symbolTable->expects($this->once())
+            ->method('getTempVariableForWrite')
+            ->with('zephir_fcall_cache_entry')
+            ->willReturn($this->createFunctionCache('_0'));
+
+        $methodCache = new MethodCache($this->createGatherer(2));
+        $cachePointer = $methodCache->get($this->createContext($symbolTable), 'process', $this->createThis(), $staticSlot);
+
+        $this->assertSame('&_0, 0', $cachePointer);
+        $this->assertFalse($staticSlot);
+    }
+
+    /** @test */
+    public function shouldNotDeclareFunctionCacheForInlineCachedCalls()
+    {
+        $symbolTable = $this->createMock(SymbolTable::class);
+        $symbolTable->expects($this->never())->method('getTempVariableForWrite');
+
+        $methodCache = new MethodCache($this->createGatherer(2));
+        $cachePointer = $methodCache->get($this->createContext($symbolTable), 'process', $this->createThis(), $staticSlot, true);
+
+        $this->assertSame('NULL, 0', $cachePointer);
+        $this->assertFalse($staticSlot);
+    }
+
+    /**
+     * Call sites without a static slot do not reuse a slot allocated by another
+     * call site for the same method, they use a function cache or an inline cache.
+     *
+     * @test
+     */
+    public function shouldNotBorrowSlotsOfOtherCallSites()
+    {
+        list($slot) = SlotsCache::replay([['m', 'Test\\Borrowed::process', true, 0]]);
+        $this->assertGreaterThan(0, $slot);
+
+        $symbolTable = $this->createMock(SymbolTable::class);
+        $symbolTable->expects($this->once())
+            ->method('getTempVariableForWrite')
+            ->willReturn($this->createFunctionCache('_0'));
+
+        $context = $this->createContext($symbolTable, 'Test\\Borrowed');
+        $methodCache = new MethodCache($this->createGatherer(2));
+
+        $this->assertSame('&_0, 0', $methodCache->get($context, 'process', $this->createThis(), $staticSlot));
+        $this->assertFalse($staticSlot);
+
+        $this->assertSame('&_0, 0', $methodCache->get($context, 'process', $this->createThis(), $staticSlot));
+        $this->assertFalse($staticSlot);
+    }
+
+    /** @test */
+    public function shouldShareSlotBetweenStaticCallSites()
+    {
+        $symbolTable = $this->createMock(SymbolTable::class);
+        $symbolTable->expects($this->once())
+            ->method('getTempVariableForWrite')
+            ->willReturn($this->createFunctionCache('_0'));
+
+        $context = $this->createContext($symbolTable, 'Test\\Monomorphic', true);
+        $methodCache = new MethodCache($this->createGatherer(2));
+
+        $first = $methodCache->get($context, 'process', $this->createThis(), $staticSlot);
+        $this->assertTrue($staticSlot);
+        $this->assertRegExp('/^&_0, [1-9][0-9]*$/', $first);
+
+        $this->assertSame($first, $methodCache->get($context, 'process', $this->createThis(), $staticSlot, true));
+        $this->assertTrue($staticSlot);
+    }
+
+    private function createContext(SymbolTable $symbolTable, $className = 'Test\\Service', $private = false)
+    {
+        $classDefinition = $this->createMock(ClassDefinition::class);
+        $classDefinition->method('getCompleteName')->willReturn($className);
+
+        $method = $this->createMock(ClassMethod::class);
+        $method->method('getName')->willReturn('process');
+        $method->method('getClassDefinition')->willReturn($classDefinition);
+        $method->method('isPrivate')->willReturn($private);
+
+        $classDefinition->method('hasMethod')->with('process')->willReturn(true);
+        $classDefinition->method('getMethod')->with('process')->willReturn($method);
+
+        $context = new CompilationContext();
+        $context->symbolTable = $symbolTable;
+        $context->classDefinition = $classDefinition;
+
+        return $context;
+    }
+
+    private function createGatherer($numberOfCalls)
+    {
+        $gatherer = $this->createMock(CallGathererPass::class);
+        $gatherer->method('getNumberOfMethodCalls')->willReturn($numberOfCalls);
+
+        return $gatherer;
+    }
+
+    private function createThis()
+    {
+        $caller = $this->createMock(Variable::class);
+        $caller->method('getRealName')->willReturn('this');
+        $caller->method('getName')->willReturn('this_ptr');
+
+        return $caller;
+    }
+
+    private function createFunctionCache($name)
+    {
+        $functionCache = $this->createMock(Variable::class);
+        $functionCache->method('getName')->willReturn($name);
+
+        return $functionCache;
+    }
+}
@@ -0,0 +1,106 @@
+<?php
+
+/*
+ * This file is part of the Zephir.
+ *
+ * (c) Zephir Team <team@zephir-lang.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code.
+ */
+
+namespace Zephir\Test;
+
+use PHPUnit\Framework\TestCase;
+use Zephir\ClassDefinition;
+use Zephir\DependencyMap;
+use Zephir\Test\FileSystem\MemoryFileSystemTrait;
+
+class DependencyMapTest extends TestCase
+{
+    use MemoryFileSystemTrait;
+
+    /** @test */
+    public function shouldInvalidateDependentsOfChangedClasses()
+    {
+        $base = new ClassDefinition('Test', 'Base');
+        $child = new ClassDefinition('Test', 'Child');
+        $child->setExtendsClassDefinition($base);
+        $user = new ClassDefinition('Test', 'User');
+        $other = new ClassDefinition('Test', 'Other');
+
+        $this->build([[$base, 'b1'], [$child, 'c1'], [$user, 'u1'], [$other, 'o1']], [
+            'Test\User' => ['test\child'],
+        ]);
+
+        $map = new DependencyMap($this->createFileSystem(), 'signature');
+        $map->computeChanges($this->createFiles([[$base, 'b2'], [$child, 'c1'], [$user, 'u1'], [$other, 'o1']]));
+
+        $this->assertNull($map->getRecord('Test\Base', 'b2'));
+        $this->assertNull($map->getRecord('Test\Child', 'c1'));
+        $this->assertNull($map->getRecord('Test\User', 'u1'));
+        $this->assertNotNull($map->getRecord('Test\Other', 'o1'));
+    }
+
+    /** @test */
+    public function shouldDiscardMapOfOtherSignature()
+    {
+        $class = new ClassDefinition('Test', 'Other');
+        $this->build([[$class, 'o1']], []);
+
+        $map = new DependencyMap($this->createFileSystem(), 'other signature');
+        $map->computeChanges($this->createFiles([[$class, 'o1']]));
+
+        $this->assertNull($map->getRecord('Test\Other', 'o1'));
+    }
+
+    private function build(array $classes, array $dependencies)
+    {
+        $map = new DependencyMap($this->createFileSystem(), 'signature');
+        $map->computeChanges($this->createFiles($classes));
+
+        foreach ($classes as $class) {
+            $className = $class[0]->getCompleteName();
+
+            $map->startRecording();
+            if (isset($dependencies[$className])) {
+                foreach ($dependencies[$className] as $dependency) {
+                    $map->addDependency($dependency);
+                }
+            }
+
+            $map->setRecord($className, ['hash' => $class[1], 'dependencies' => $map->stopRecording()]);
+        }
+
+        $map->save();
+    }
+
+    private function createFiles(array $classes)
+    {
+        $files = [];
+        foreach ($classes as $class) {
+            $files[] = new class($class[0], $class[1]) {
+                private $classDefinition;
+                private $hash;
+
+                public function __construct(ClassDefinition $classDefinition, $hash)
+                {
+                    $this->classDefinition = $classDefinition;
+                    $this->hash = $hash;
+                }
+
+                public function getClassDefinition()
+                {
+                    return $this->classDefinition;
+                }
+
+                public function getSourceHash()
+                {
+                    return $this->hash;
+                }
+            };
+        }
+
+        return $files;
+    }
+}
@@ -0,0 +1,39 @@
+<?php
+
+/*
+ * This file is part of the Zephir.
+ *
+ * (c) Zephir Team <team@zephir-lang.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code.
+ */
+
+namespace Zephir\Test\FileSystem;
+
+use Zephir\FileSystem\FileSystemInterface;
+
+/**
+ * Provides a file system kept in memory, shared by every file system created by the test.
+ */
+trait MemoryFileSystemTrait
+{
+    private $files = [];
+
+    private function createFileSystem()
+    {
+        $filesystem = $this->createMock(FileSystemInterface::class);
+
+        $filesystem->method('exists')->willReturnCallback(function ($path) {
+            return isset($this->files[$path]);
+        });
+        $filesystem->method('read')->willReturnCallback(function ($path) {
+            return $this->files[$path];
+        });
+        $filesystem->method('write')->willReturnCallback(function ($path, $data) {
+            $this->files[$path] = $data;
+        });
+
+        return $filesystem;
+    }
+}
@@ -13,7 +13,9 @@ namespace Zephir\Test;
 
 use PHPUnit\Framework\TestCase;
 use function Zephir\camelize;
+use function Zephir\cpu_count;
 use function Zephir\escape_class;
+use function Zephir\make_jobs;
 
 class HelpersTest extends TestCase
 {
@@ -36,4 +38,31 @@ class HelpersTest extends TestCase
             'FooBarFooBar'
         );
     }
+
+    /**
+     * @test
+     * @dataProvider jobsProvider
+     */
+    public function shouldResolveNumberOfMakeJobs($jobs, $expected)
+    {
+        $this->assertSame($expected, make_jobs($jobs));
+    }
+
+    public function jobsProvider()
+    {
+        return [
+            'one job' => ['1', 1],
+            'several jobs' => ['8', 8],
+            'integer' => [3, 3],
+            'negative' => ['-2', 1],
+            'not a number' => ['all', 1],
+        ];
+    }
+
+    /** @test */
+    public function shouldDefaultMakeJobsToNumberOfCpus()
+    {
+        $this->assertSame(cpu_count(), make_jobs(null));
+        $this->assertSame(cpu_count(), make_jobs('0'));
+    }
 }
@@ -0,0 +1,23 @@
+namespace Internalcalls;
+
+class Caller
+{
+	public function callNew(var n)
+	{
+		var target;
+
+		let target = new Target();
+
+		return target->value(n);
+	}
+
+	public function callTarget(<Target> target, var n)
+	{
+		return target->value(n);
+	}
+
+	public function callHidden()
+	{
+		return Target::hidden();
+	}
+}
@@ -0,0 +1,19 @@
+namespace Internalcalls;
+
+class Target
+{
+	public function value(var n)
+	{
+		return n * 2;
+	}
+
+	public function callValue(var n)
+	{
+		return this->value(n);
+	}
+
+	protected static function hidden()
+	{
+		return "hidden";
+	}
+}
@@ -0,0 +1,25 @@
+<?php
+
+class Sub extends \Internalcalls\Target
+{
+    public function value($n)
+    {
+        return $n * 3;
+    }
+}
+
+$caller = new \Internalcalls\Caller();
+$target = new \Internalcalls\Target();
+$sub = new Sub();
+
+echo $caller->callNew(5), PHP_EOL;
+echo $caller->callTarget($target, 5), PHP_EOL;
+echo $caller->callTarget($sub, 5), PHP_EOL;
+echo $target->callValue(5), PHP_EOL;
+echo $sub->callValue(5), PHP_EOL;
+
+try {
+    echo @$caller->callHidden(), PHP_EOL;
+} catch (\Throwable $e) {
+    echo 'refused', PHP_EOL;
+}
@@ -0,0 +1,24 @@
+#!/bin/sh
+
+test_description="Test parallel code generation"
+
+. ./setup.sh
+
+# Skip all remaining tests if prerequisite is not met.
+if ! $PHP -r 'exit(function_exists("pcntl_fork") && function_exists("posix_kill") ? 0 : 1);'; then
+	skip_all='skipping parallel generation tests, these tests require the pcntl and posix extensions'
+	test_done
+fi
+
+test_expect_success "Should generate the same sources with and without workers" '
+	mkdir jobs &&
+	cp -R $ZEPHIRDIR/config.json $ZEPHIRDIR/test jobs/ &&
+	cd jobs &&
+	zephir generate --backend=ZendEngine3 --jobs=1 2>&1 >/dev/null &&
+	mv ext ext-serial &&
+	rm -rf .zephir &&
+	zephir generate --backend=ZendEngine3 --jobs=4 2>&1 >/dev/null &&
+	diff -r ext-serial ext
+'
+
+test_done
@@ -0,0 +1,32 @@
+#!/bin/sh
+
+test_description="Test direct calls of internal methods"
+
+. ./setup.sh
+
+# Skip all remaining tests if prerequisite is not met.
+if test $PHP_VERSION_ID -lt 70000; then
+	skip_all='skipping internal call tests, these tests are designed to use for PHP > 7.0.0'
+	test_done
+fi
+
+test_expect_success "Should guard direct calls by the class entry of the receiver" '
+	cd $FIXTURESDIR/internalcalls &&
+	zephir fullclean 2>&1 >/dev/null &&
+	zephir compile --backend=ZendEngine3 2>&1 >/dev/null &&
+	grep -q "Z_OBJCE_P(.*) == internalcalls_target_ce" ext/internalcalls/caller.zep.c &&
+	grep -q "Z_OBJCE_P(this_ptr) == internalcalls_target_ce" ext/internalcalls/target.zep.c
+'
+
+test_expect_success "Should not call methods invisible from the caller directly" '
+	cd $FIXTURESDIR/internalcalls &&
+	! grep -q "hidden_zephir_internal_call" ext/internalcalls/caller.zep.c
+'
+
+test_expect_success "Should fall back to the method call for other receivers" '
+	cd $FIXTURESDIR/internalcalls &&
+	$PHP -d extension=ext/modules/internalcalls.so test.php > "$SHARNESS_TRASH_DIRECTORY/actual" &&
+	test_cmp expected.txt "$SHARNESS_TRASH_DIRECTORY/actual"
+'
+
+test_done